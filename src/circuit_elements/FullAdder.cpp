@@ -0,0 +1,70 @@
+#include "FullAdder.h"
+#include "../managers/ResourceManager.h"
+#include "../simulation/Subcircuit.h"
+#include <iostream>
+
+namespace {
+
+std::shared_ptr<const SubcircuitDefinition> BuildFullAdder() {
+    Netlist body;
+    GateId a = body.AddGate(GateKind::INPUT, 0);
+    GateId b = body.AddGate(GateKind::INPUT, 0);
+    GateId carryIn = body.AddGate(GateKind::INPUT, 0);
+
+    GateId sum = body.AddGate(GateKind::XOR, 3);
+    body.ConnectInput(sum, 0, body.GetOutput(a));
+    body.ConnectInput(sum, 1, body.GetOutput(b));
+    body.ConnectInput(sum, 2, body.GetOutput(carryIn));
+
+    // carry = a & b | (a ^ b) & carryIn
+    GateId half = body.AddGate(GateKind::XOR, 2);
+    body.ConnectInput(half, 0, body.GetOutput(a));
+    body.ConnectInput(half, 1, body.GetOutput(b));
+    GateId generate = body.AddGate(GateKind::AND, 2);
+    body.ConnectInput(generate, 0, body.GetOutput(a));
+    body.ConnectInput(generate, 1, body.GetOutput(b));
+    GateId propagate = body.AddGate(GateKind::AND, 2);
+    body.ConnectInput(propagate, 0, body.GetOutput(half));
+    body.ConnectInput(propagate, 1, body.GetOutput(carryIn));
+    GateId carryOut = body.AddGate(GateKind::OR, 2);
+    body.ConnectInput(carryOut, 0, body.GetOutput(generate));
+    body.ConnectInput(carryOut, 1, body.GetOutput(propagate));
+
+    // Output ports follow slot order: sum, then carry out
+    body.SetProbed(sum, true);
+    body.SetProbed(carryOut, true);
+
+    auto definition = std::make_shared<SubcircuitDefinition>();
+    std::string error;
+    if (!definition->Compile(body, error)) {
+        std::cerr << "Full adder definition failed: " << error << std::endl;
+        return nullptr;
+    }
+    return definition;
+}
+
+} // namespace
+
+FullAdder::FullAdder(Vector2 position) : Component(position, "full_adder", GateKind::SUBCIRCUIT, 3, 2) {
+    ResourceManager::getInstance().loadSVGTexture("full_adder", "assets/full_adder.svg", 200, 200);
+    std::cout << "Full adder created at position: (" << position.x << ", " << position.y << ")" << std::endl;
+
+    // Sum on top, carry out below, matching the SVG
+    outputPins[0] = {1.0f, -0.25f};
+    outputPins[1] = {1.0f, 0.25f};
+}
+
+void FullAdder::Update() {
+    // Outputs come from the simulated instance through SimulationManager
+}
+
+void FullAdder::Draw() const {
+    DrawComponent();
+    DrawPins();
+    DrawDebugFrames();
+}
+
+std::shared_ptr<const SubcircuitDefinition> FullAdder::GetSubcircuitDefinition() const {
+    static const std::shared_ptr<const SubcircuitDefinition> definition = BuildFullAdder();
+    return definition;
+}
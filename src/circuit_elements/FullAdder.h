@@ -0,0 +1,18 @@
+#ifndef FULL_ADDER_H
+#define FULL_ADDER_H
+
+#include "../core/Component.h"
+
+// One-bit full adder placed as a subcircuit: inputs A, B and carry in,
+// outputs sum and carry out. Every adder shares one compiled definition and
+// the simulator evaluates them together as a batch.
+class FullAdder : public Component {
+public:
+    FullAdder(Vector2 position);
+    void Update() override;
+    void Draw() const override;
+
+    std::shared_ptr<const SubcircuitDefinition> GetSubcircuitDefinition() const override;
+};
+
+#endif // FULL_ADDER_H
@@ -1,11 +1,12 @@
 #include "InputSwitch.h"
 #include "../managers/ResourceManager.h"
+#include "../managers/SimulationManager.h"
 #include <iostream>
 #include <raymath.h>
 
 const float InputSwitch::SWITCH_RADIUS = 10.0f;
 
-InputSwitch::InputSwitch(Vector2 position) : Component(position, "input_switch", 0, 1), state(false) {
+InputSwitch::InputSwitch(Vector2 position) : Component(position, "input_switch", GateKind::INPUT, 0, 1), state(false) {
     std::cout << "InputSwitch created at position: (" << position.x << ", " << position.y << ")" << std::endl;
 }
 
@@ -33,6 +34,7 @@ bool InputSwitch::IsHovered(Vector2 mousePosition) {
 
 void InputSwitch::ToggleState() {
     state = !state;
+    SimulationManager::getInstance().setInputValue(this, state);
     std::cout << "InputSwitch state toggled to: " << (state ? "ON" : "OFF") << std::endl;
 }
 
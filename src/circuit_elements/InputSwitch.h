@@ -10,6 +10,7 @@ public:
     void Draw() const override;
 	bool IsHovered(Vector2 mousePosition);
 	void ToggleState();
+	bool GetState() const { return state; }
 
 	Vector2 GetOutputPinPosition(int index) const override;
 
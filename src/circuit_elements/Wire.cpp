@@ -19,11 +19,12 @@ Wire::~Wire()
 
 void Wire::Update()
 {
-    // Update the wire's signal state based on the start component's output
-    signalState = startComponent->GetOutputState(startPinIndex - startComponent->GetNumInputs());
-    
-    // Propagate the signal to the end component
-    endComponent->SetInputState(endPinIndex, signalState);
+    // Signal values come from the simulator; show whichever end drives the wire
+    if (startPinIndex >= startComponent->GetNumInputs()) {
+        signalState = startComponent->GetOutputState(startPinIndex - startComponent->GetNumInputs());
+    } else {
+        signalState = endComponent->GetOutputState(endPinIndex - endComponent->GetNumInputs());
+    }
 
     // Recalculate wire points in case components have moved or rotated
     RecalculateWirePath();
@@ -7,12 +7,17 @@ const float Component::PIN_RADIUS = 5.0f;
 const float Component::PIN_HOVER_RADIUS = 10.0f;
 bool Component::showDebugFrames = false;
 
-Component::Component(Vector2 position, const std::string& textureKey, int numInputs, int numOutputs)
-    : position(position), textureKey(textureKey), numInputs(numInputs), numOutputs(numOutputs), isHighlighted(false), scale(1.0f), rotation(0.0f)
+Component::Component(Vector2 position, const std::string& textureKey, GateKind gateKind, int numInputs, int numOutputs)
+    : position(position), textureKey(textureKey), gateKind(gateKind), numInputs(numInputs), numOutputs(numOutputs), isHighlighted(false), scale(1.0f), rotation(0.0f)
 {
     inputStates.resize(numInputs, false);
     outputStates.resize(numOutputs, false);
     
+    // Wide gates grow taller, two input pins per grid cell
+    if (numInputs > 4) {
+        size.y = static_cast<float>(GRID_SIZE * ((numInputs + 1) / 2));
+    }
+
     // Default pin positions (to be overridden by specific components)
     for (int i = 0; i < numInputs; ++i) {
         inputPins.push_back({-1.0f, -0.5f + (1.0f / (numInputs + 1)) * (i + 1)});
@@ -2,16 +2,19 @@
 #define COMPONENT_H
 
 #include "raylib.h"
+#include "../simulation/GateKind.h"
+#include <memory>
 #include <string>
 #include <vector>
 
+class SubcircuitDefinition;
 class Wire;
 class ConnectionManager;
 class ComponentManager; // Forward declaration
 
 class Component {
 public:
-    Component(Vector2 position, const std::string& textureKey, int numInputs, int numOutputs);
+    Component(Vector2 position, const std::string& textureKey, GateKind gateKind, int numInputs, int numOutputs);
     virtual ~Component() = default;
 
     virtual void Update() = 0;
@@ -39,6 +42,15 @@ public:
     void SetInputState(int inputIndex, bool state);
     void SetOutputState(int outputIndex, bool state);
 
+    // Primitive the simulator evaluates this component as
+    GateKind GetGateKind() const { return gateKind; }
+    // Shared body of SUBCIRCUIT components; output pin k is port k
+    virtual std::shared_ptr<const SubcircuitDefinition> GetSubcircuitDefinition() const { return nullptr; }
+
+    // Propagation delay in simulation time units, used by the timed engine
+    int GetDelay() const { return delay; }
+    void SetDelay(int newDelay) { delay = newDelay < 1 ? 1 : newDelay; }
+
     int GetNumInputs() const { return numInputs; }
     int GetNumOutputs() const { return numOutputs; }
 
@@ -74,6 +86,7 @@ public:
 
 public:
     static const int GRID_SIZE = 32; // Size of one grid cell
+    static const int MAX_GATE_INPUTS = 64; // Widest AND/OR/XOR the editor places
 
     static const float PIN_RADIUS;
     static const float PIN_HOVER_RADIUS;
@@ -86,6 +99,7 @@ protected:
     Vector2 position;
     std::string textureKey;
     void DrawDebugFrames() const;
+    GateKind gateKind;
     int numInputs;
     int numOutputs;
     std::vector<bool> inputStates;
@@ -95,6 +109,7 @@ protected:
     ComponentManager* componentManager;
     float scale = 1.0f;
     float rotation = 0.0f;
+    int delay = 1;
     friend class ConnectionManager;
 };
 
@@ -13,5 +13,7 @@ enum class ComponentType {
     AND,
     OR,
     NOT,
-    INPUT_SWITCH
+    INPUT_SWITCH,
+    XOR,
+    FULL_ADDER
 };
@@ -3,20 +3,23 @@
 #include <iostream>
 #include <raymath.h>
 
-AndGate::AndGate(Vector2 position) : Component(position, "and_gate", 2, 1) {
+AndGate::AndGate(Vector2 position, int numInputs) : Component(position, "and_gate", GateKind::AND, numInputs, 1) {
     // Load the SVG texture for the AND gate
     ResourceManager::getInstance().loadSVGTexture("and_gate", "assets/and_gate.svg", 200, 200);
     std::cout << "AND gate created at position: (" << position.x << ", " << position.y << ")" << std::endl;
 
-    // Set pin positions based on the SVG
-    inputPins[0] = {-1.0f, -0.4f};
-    inputPins[1] = {-1.0f, 0.4f};
+    // Set pin positions based on the SVG; wider gates keep the evenly spaced defaults
+    if (numInputs == 2) {
+        inputPins[0] = {-1.0f, -0.4f};
+        inputPins[1] = {-1.0f, 0.4f};
+    }
     outputPins[0] = {1.0f, 0.0f};
 }
 
 void AndGate::Update() {
     // Perform AND operation
-    bool result = GetInputState(0) && GetInputState(1);
+    bool result = numInputs != 0;
+    for (int i = 0; i < numInputs; ++i) result = result && GetInputState(i);
     outputStates[0] = result;
 }
 
@@ -32,6 +35,9 @@ bool AndGate::IsHovered(Vector2 mousePosition) {
 }
 
 Vector2 AndGate::GetInputPinPosition(int index) const {
+    if (numInputs != 2) {
+        return Component::GetInputPinPosition(index);
+    }
     Vector2 localPos;
     if (index == 0) {
         localPos = { -size.x / 2, -size.y / 2 + 30 };
@@ -5,7 +5,7 @@
 
 class AndGate : public Component {
 public:
-    AndGate(Vector2 position);
+    AndGate(Vector2 position, int numInputs = 2);
     void Update() override;
     void Draw() const override;
     bool IsHovered(Vector2 mousePosition);
@@ -3,7 +3,7 @@
 #include <iostream>
 #include <raymath.h>
 
-NotGate::NotGate(Vector2 position) : Component(position, "not_gate", 1, 1) {
+NotGate::NotGate(Vector2 position) : Component(position, "not_gate", GateKind::NOT, 1, 1) {
     // Load the SVG texture for the NOT gate
     ResourceManager::getInstance().loadSVGTexture("not_gate", "assets/not_gate.svg", 200, 200);
     std::cout << "NOT gate created at position: (" << position.x << ", " << position.y << ")" << std::endl;
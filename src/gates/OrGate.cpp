@@ -3,20 +3,23 @@
 #include <iostream>
 #include <raymath.h>
 
-OrGate::OrGate(Vector2 position) : Component(position, "or_gate", 2, 1) {
+OrGate::OrGate(Vector2 position, int numInputs) : Component(position, "or_gate", GateKind::OR, numInputs, 1) {
     // Load the SVG texture for the OR gate
     ResourceManager::getInstance().loadSVGTexture("or_gate", "assets/or_gate.svg", 200, 200);
     std::cout << "OR gate created at position: (" << position.x << ", " << position.y << ")" << std::endl;
 
-    // Set pin positions based on the SVG
-    inputPins[0] = {-1.0f, -0.4f};
-    inputPins[1] = {-1.0f, 0.4f};
+    // Set pin positions based on the SVG; wider gates keep the evenly spaced defaults
+    if (numInputs == 2) {
+        inputPins[0] = {-1.0f, -0.4f};
+        inputPins[1] = {-1.0f, 0.4f};
+    }
     outputPins[0] = {1.0f, 0.0f};
 }
 
 void OrGate::Update() {
     // Perform OR operation
-    bool result = GetInputState(0) || GetInputState(1);
+    bool result = false;
+    for (int i = 0; i < numInputs; ++i) result = result || GetInputState(i);
     outputStates[0] = result;
 }
 
@@ -33,6 +36,9 @@ bool OrGate::IsHovered(Vector2 mousePosition) {
 }
 
 Vector2 OrGate::GetInputPinPosition(int index) const {
+    if (numInputs != 2) {
+        return Component::GetInputPinPosition(index);
+    }
     Vector2 localPos;
     if (index == 0) {
         localPos = { -size.x / 2, -size.y / 2 + 30 };
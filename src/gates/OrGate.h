@@ -5,7 +5,7 @@
 
 class OrGate : public Component {
 public:
-    OrGate(Vector2 position);
+    OrGate(Vector2 position, int numInputs = 2);
     void Update() override;
     void Draw() const override;
     bool IsHovered(Vector2 mousePosition);
@@ -0,0 +1,20 @@
+#ifndef XOR_GATE_H
+#define XOR_GATE_H
+
+#include "../core/Component.h"
+
+class XorGate : public Component {
+public:
+    XorGate(Vector2 position, int numInputs = 2);
+    void Update() override;
+    void Draw() const override;
+    bool IsHovered(Vector2 mousePosition);
+
+    Vector2 GetInputPinPosition(int index) const override;
+    Vector2 GetOutputPinPosition(int index) const override;
+
+protected:
+    // Using the default size from Component class
+};
+
+#endif // XOR_GATE_H
@@ -1,10 +1,14 @@
 #include "Input.h"
 #include "../managers/ComponentManager.h"
 #include "../managers/ConnectionManager.h"
+#include "../managers/SimulationManager.h"
 #include "../gates/AndGate.h"
 #include "../gates/OrGate.h"
 #include "../gates/NotGate.h"
+#include "../gates/XorGate.h"
 #include "../circuit_elements/InputSwitch.h"
+#include "../circuit_elements/FullAdder.h"
+#include <algorithm>
 #include <iostream>
 #include <raymath.h>
 
@@ -29,13 +33,15 @@ void Input::HandleInput(ProgramState& currentState,
     // Handle toolbar interactions
     if (mousePosition.y < renderer->GetToolbarHeight()) {
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            int buttonWidth = GetScreenWidth() / 4;
+            int buttonWidth = GetScreenWidth() / 6;
             int clickedButton = mousePosition.x / buttonWidth;
             switch (clickedButton) {
                 case 0: currentComponentType = ComponentType::AND; currentState = ProgramState::PLACING_COMPONENT; break;
                 case 1: currentComponentType = ComponentType::OR; currentState = ProgramState::PLACING_COMPONENT; break;
                 case 2: currentComponentType = ComponentType::NOT; currentState = ProgramState::PLACING_COMPONENT; break;
                 case 3: currentComponentType = ComponentType::INPUT_SWITCH; currentState = ProgramState::PLACING_COMPONENT; break;
+                case 4: currentComponentType = ComponentType::XOR; currentState = ProgramState::PLACING_COMPONENT; break;
+                case 5: currentComponentType = ComponentType::FULL_ADDER; currentState = ProgramState::PLACING_COMPONENT; break;
             }
         }
         return;  // Exit early if interacting with toolbar
@@ -46,6 +52,16 @@ void Input::HandleInput(ProgramState& currentState,
     if (IsKeyPressed(KEY_O)) { currentComponentType = ComponentType::OR; currentState = ProgramState::PLACING_COMPONENT; }
     if (IsKeyPressed(KEY_N)) { currentComponentType = ComponentType::NOT; currentState = ProgramState::PLACING_COMPONENT; }
     if (IsKeyPressed(KEY_I)) { currentComponentType = ComponentType::INPUT_SWITCH; currentState = ProgramState::PLACING_COMPONENT; }
+    if (IsKeyPressed(KEY_X)) { currentComponentType = ComponentType::XOR; currentState = ProgramState::PLACING_COMPONENT; }
+    if (IsKeyPressed(KEY_S)) { currentComponentType = ComponentType::FULL_ADDER; currentState = ProgramState::PLACING_COMPONENT; }
+
+    // Input count of the next AND, OR or XOR gate placed
+    static int placementInputs = 2;
+    if (currentState == ProgramState::PLACING_COMPONENT && (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_DOWN))) {
+        placementInputs += IsKeyPressed(KEY_UP) ? 1 : -1;
+        placementInputs = std::clamp(placementInputs, 2, Component::MAX_GATE_INPUTS);
+        std::cout << "Gate inputs set to: " << placementInputs << std::endl;
+    }
 
     // Handle rotation
     if (IsKeyPressed(KEY_R)) {
@@ -58,6 +74,23 @@ void Input::HandleInput(ProgramState& currentState,
         }
     }
 
+    // Adjust the propagation delay of the selected component
+    if (selectedComponent && (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_MINUS))) {
+        int delay = selectedComponent->GetDelay() + (IsKeyPressed(KEY_EQUAL) ? 1 : -1);
+        SimulationManager::getInstance().setDelay(selectedComponent, delay);
+        std::cout << "Component delay set to: " << selectedComponent->GetDelay() << std::endl;
+    }
+
+    // Optimizer hints: probe the selected component, or fix the selected switch's value
+    if (selectedComponent && IsKeyPressed(KEY_P)) {
+        bool probed = SimulationManager::getInstance().toggleProbe(selectedComponent);
+        std::cout << "Probe " << (probed ? "added" : "removed") << std::endl;
+    }
+    if (selectedComponent && IsKeyPressed(KEY_L) && selectedComponent->GetGateKind() == GateKind::INPUT) {
+        bool fixed = SimulationManager::getInstance().toggleFixedInput(selectedComponent);
+        std::cout << "Input switch " << (fixed ? "fixed" : "released") << std::endl;
+    }
+
     // Handle panning with right mouse button
     if (IsMouseButtonDown(MOUSE_RIGHT_BUTTON)) {
         Vector2 mouseDelta = GetMouseDelta();
@@ -97,9 +130,8 @@ void Input::HandleInput(ProgramState& currentState,
                         selectedComponent = clickedComponent;
                         currentState = ProgramState::SELECTING;
                         // Toggle input switch if clicked
-                        InputSwitch* inputSwitch = dynamic_cast<InputSwitch*>(clickedComponent);
-                        if (inputSwitch) {
-                            inputSwitch->ToggleState();
+                        if (clickedComponent->GetGateKind() == GateKind::INPUT) {
+                            static_cast<InputSwitch*>(clickedComponent)->ToggleState();
                         }
                     } else {
                         selectedComponent = nullptr;
@@ -112,10 +144,13 @@ void Input::HandleInput(ProgramState& currentState,
                     Component* newComponent = nullptr;
                     switch (currentComponentType) {
                         case ComponentType::AND:
-                            newComponent = new AndGate(snappedPosition);
+                            newComponent = new AndGate(snappedPosition, placementInputs);
                             break;
                         case ComponentType::OR:
-                            newComponent = new OrGate(snappedPosition);
+                            newComponent = new OrGate(snappedPosition, placementInputs);
+                            break;
+                        case ComponentType::XOR:
+                            newComponent = new XorGate(snappedPosition, placementInputs);
                             break;
                         case ComponentType::NOT:
                             newComponent = new NotGate(snappedPosition);
@@ -123,6 +158,9 @@ void Input::HandleInput(ProgramState& currentState,
                         case ComponentType::INPUT_SWITCH:
                             newComponent = new InputSwitch(snappedPosition);
                             break;
+                        case ComponentType::FULL_ADDER:
+                            newComponent = new FullAdder(snappedPosition);
+                            break;
                     }
                     if (newComponent) {
                         newComponent->SetComponentManager(&ComponentManager::getInstance());
@@ -145,6 +183,7 @@ void Input::HandleInput(ProgramState& currentState,
                         if (endPin != -1) {
                             Wire* newWire = new Wire(wireStartComponent, wireStartPin, endComponent, endPin);
                             wires.push_back(newWire);
+                            SimulationManager::getInstance().addWire(newWire);
                         }
                     }
                     wireStartComponent = nullptr;
@@ -176,6 +215,78 @@ void Input::HandleInput(ProgramState& currentState,
         Component::ToggleDebugFrames();
     }
 
+    if (IsKeyPressed(KEY_E)) {
+        SimulationManager::getInstance().cycleEngine();
+    }
+
+    if (IsKeyPressed(KEY_C)) {
+        SimulationManager::getInstance().compileCircuit();
+    }
+
+    // Truth table of the logic feeding the selected component, or of the whole sheet
+    if (IsKeyPressed(KEY_T)) {
+        std::string error;
+        if (SimulationManager::getInstance().exportTruthTable(selectedComponent, "truth_table.csv", error)) {
+            std::cout << "Writing truth table to truth_table.csv" << std::endl;
+        } else {
+            std::cout << "Truth table failed: " << error << std::endl;
+        }
+    }
+
+    // Waveform dump of the probed nets, or of every net, as VCD ('W') or binary trace ('B')
+    if (IsKeyPressed(KEY_W) || IsKeyPressed(KEY_B)) {
+        const char* path = IsKeyPressed(KEY_W) ? "waveform.vcd" : "waveform.trace";
+        std::string error;
+        if (SimulationManager::getInstance().toggleWaveformDump(path, error)) {
+            std::cout << "Dumping waveforms to " << path << std::endl;
+        } else if (!error.empty()) {
+            std::cout << "Waveform dump failed: " << error << std::endl;
+        } else {
+            std::cout << "Waveform dump stopped" << std::endl;
+        }
+    }
+
+    // Stuck-at fault coverage of the stimulus in stimulus.txt
+    if (IsKeyPressed(KEY_G)) {
+        std::string error;
+        if (SimulationManager::getInstance().exportFaultReport("stimulus.txt", "fault_report.txt", error)) {
+            std::cout << "Grading faults into fault_report.txt" << std::endl;
+        } else {
+            std::cout << "Fault simulation failed: " << error << std::endl;
+        }
+    }
+
+    // Simulation speed controls
+    if (IsKeyPressed(KEY_SPACE)) {
+        SimulationManager::getInstance().togglePause();
+    }
+    if (IsKeyPressed(KEY_PERIOD)) {
+        SimulationManager::getInstance().stepOnce();
+    }
+    if (IsKeyPressed(KEY_COMMA)) {
+        SimulationManager::getInstance().stepBack();
+    }
+    if (IsKeyPressed(KEY_RIGHT_BRACKET)) {
+        SimulationManager::getInstance().scaleTickRate(2.0);
+    }
+    if (IsKeyPressed(KEY_LEFT_BRACKET)) {
+        SimulationManager::getInstance().scaleTickRate(0.5);
+    }
+    if (IsKeyPressed(KEY_U)) {
+        SimulationManager::getInstance().toggleUnlimitedTickRate();
+    }
+
+    // Timing diagram of the probed gates; '9' and '0' zoom out and in
+    if (IsKeyPressed(KEY_V)) {
+        SimulationManager::getInstance().toggleTimingView();
+    }
+    if (IsKeyPressed(KEY_NINE)) {
+        SimulationManager::getInstance().scaleTimingWindow(4.0);
+    }
+    if (IsKeyPressed(KEY_ZERO)) {
+        SimulationManager::getInstance().scaleTimingWindow(0.25);
+    }
+
     // Handle wire deletion
     static Wire* highlightedWire = nullptr;
     Wire* wireUnderMouse = GetWireAtPosition(worldMousePos);
@@ -8,6 +8,7 @@
 #include "managers/ResourceManager.h"
 #include "managers/ComponentManager.h"
 #include "managers/ConnectionManager.h"
+#include "managers/SimulationManager.h"
 #include "rendering/Renderer.h"
 #include "core/GameState.h"
 #include "input/Input.h"
@@ -40,15 +41,13 @@ Camera2D camera = { 0 };
 Renderer* renderer = nullptr;
 
 void Update() {
-    // Update all wires
+    // Pull the latest simulated values from the simulation thread
+    SimulationManager::getInstance().update();
+
+    // Refresh wire signal colours and paths
     for (auto& wire : wires) {
         wire->Update();
     }
-
-    // Update all components
-    for (auto& component : ComponentManager::getInstance().getComponents()) {
-        component->Update();
-    }
 }
 
 int main() {
@@ -67,12 +66,17 @@ int main() {
     ResourceManager::getInstance().loadSVGTexture("or_gate", "assets/or_gate.svg", 64, 64);
     ResourceManager::getInstance().loadSVGTexture("not_gate", "assets/not_gate.svg", 64, 64);
     ResourceManager::getInstance().loadSVGTexture("input_switch", "assets/input_switch.svg", 64, 64);
+    ResourceManager::getInstance().loadSVGTexture("xor_gate", "assets/xor_gate.svg", 64, 64);
+    ResourceManager::getInstance().loadSVGTexture("full_adder", "assets/full_adder.svg", 64, 64);
 
     ComponentManager::getInstance().setInitialScreenSize(SCREEN_WIDTH, SCREEN_HEIGHT);
 
     // Create Renderer instance
     renderer = new Renderer(camera, ComponentManager::getInstance(), wires);
 
+    // Simulation runs on its own thread at its own tick rate
+    SimulationManager::getInstance().start();
+
     while (!WindowShouldClose()) {
         Input::HandleInput(currentState, currentComponentType, wireStartComponent, wireStartPin, wireEndPos, showDebugInfo, selectedComponent, placementRotation, camera, renderer, wires);
         Update();
@@ -82,6 +86,7 @@ int main() {
     }
 
     // Clean up
+    SimulationManager::getInstance().stop();
     delete renderer;
 
     // Clean up components and wires
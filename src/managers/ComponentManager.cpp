@@ -1,4 +1,5 @@
 #include "ComponentManager.h"
+#include "SimulationManager.h"
 #include "../core/Component.h"
 #include <algorithm>
 
@@ -10,9 +11,11 @@ ComponentManager& ComponentManager::getInstance() {
 void ComponentManager::addComponent(Component* component) {
     components.push_back(component);
     component->SetComponentManager(this);
+    SimulationManager::getInstance().addComponent(component);
 }
 
 void ComponentManager::removeComponent(Component* component) {
+    SimulationManager::getInstance().removeComponent(component);
     components.erase(std::remove(components.begin(), components.end(), component), components.end());
 }
 
@@ -1,4 +1,5 @@
 #include "ConnectionManager.h"
+#include "SimulationManager.h"
 #include "../circuit_elements/Wire.h"
 #include "raymath.h"
 
@@ -19,6 +20,7 @@ void ConnectionManager::addWire(Wire* wire) {
     wires.push_back(wire);
     addWireToComponent(wire->GetStartComponent(), wire);
     addWireToComponent(wire->GetEndComponent(), wire);
+    SimulationManager::getInstance().addWire(wire);
 }
 
 void ConnectionManager::removeWire(Wire* wire) {
@@ -26,6 +28,7 @@ void ConnectionManager::removeWire(Wire* wire) {
     if (it != wires.end()) {
         removeWireFromComponent(wire->GetStartComponent(), wire);
         removeWireFromComponent(wire->GetEndComponent(), wire);
+        SimulationManager::getInstance().removeWire(wire);
         wires.erase(it);
         delete wire;
     }
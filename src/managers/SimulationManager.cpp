@@ -0,0 +1,451 @@
+#include "SimulationManager.h"
+#include "ComponentManager.h"
+#include "../core/Component.h"
+#include "../circuit_elements/Wire.h"
+#include "../simulation/TruthTable.h"
+#include "../simulation/FaultSimulator.h"
+#include "../simulation/TraceWriter.h"
+#include "../simulation/VcdWriter.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+// Gates a component is simulated as: its own gate, or every port of its
+// subcircuit instance
+std::span<const GateId> getSimulatedGates(const Netlist& netlist, const GateId& gate) {
+    SubcircuitId instance = netlist.GetSubcircuitOf(gate);
+    return instance == INVALID_SUBCIRCUIT ? std::span<const GateId>(&gate, 1) : netlist.GetSubcircuitPorts(instance);
+}
+
+} // namespace
+
+SimulationManager& SimulationManager::getInstance() {
+    static SimulationManager instance;
+    return instance;
+}
+
+SimulationManager::SimulationManager() : simulationThread(simulator) {
+    simulationThread.SetTickRate(DEFAULT_TICK_RATE);
+    simulator.SetHistoryEnabled(true);
+}
+
+void SimulationManager::addComponent(Component* component) {
+    if (gateIds.count(component)) return;
+
+    GateKind kind = component->GetGateKind();
+    if (kind == GateKind::NONE) return;
+
+    auto lock = simulationThread.Lock();
+    Netlist& netlist = simulator.GetNetlist();
+    GateId gate;
+    if (kind == GateKind::SUBCIRCUIT) {
+        // The component maps to the instance's first port; removing it
+        // removes the whole instance
+        SubcircuitId instance = netlist.AddSubcircuit(component->GetSubcircuitDefinition());
+        if (instance == INVALID_SUBCIRCUIT) return;
+        gate = netlist.GetSubcircuitPorts(instance)[0];
+    } else {
+        gate = netlist.AddGate(kind, component->GetNumInputs());
+    }
+    for (GateId simulated : getSimulatedGates(netlist, gate)) {
+        netlist.SetGateDelay(simulated, static_cast<uint32_t>(component->GetDelay()));
+    }
+    gateIds[component] = gate;
+}
+
+void SimulationManager::removeComponent(Component* component) {
+    auto lock = simulationThread.Lock();
+    auto it = gateIds.find(component);
+    if (it != gateIds.end()) {
+        simulator.GetNetlist().RemoveGate(it->second);
+        gateIds.erase(it);
+    }
+}
+
+void SimulationManager::addWire(Wire* wire) {
+    GateId driver, reader;
+    int readerPin;
+    auto lock = simulationThread.Lock();
+    if (resolveWire(wire, driver, reader, readerPin)) {
+        Netlist& netlist = simulator.GetNetlist();
+        netlist.ConnectInput(reader, readerPin, netlist.GetOutput(driver));
+    }
+}
+
+void SimulationManager::removeWire(Wire* wire) {
+    GateId driver, reader;
+    int readerPin;
+    auto lock = simulationThread.Lock();
+    if (resolveWire(wire, driver, reader, readerPin)) {
+        simulator.GetNetlist().DisconnectInput(reader, readerPin);
+    }
+}
+
+void SimulationManager::setInputValue(Component* component, bool value) {
+    GateId gate = getGateId(component);
+    if (gate != INVALID_GATE) {
+        auto lock = simulationThread.Lock();
+        simulator.GetNetlist().SetInputValue(gate, value);
+    }
+}
+
+void SimulationManager::setDelay(Component* component, int delay) {
+    component->SetDelay(delay);
+    GateId gate = getGateId(component);
+    if (gate != INVALID_GATE) {
+        auto lock = simulationThread.Lock();
+        Netlist& netlist = simulator.GetNetlist();
+        for (GateId simulated : getSimulatedGates(netlist, gate)) {
+            netlist.SetGateDelay(simulated, static_cast<uint32_t>(component->GetDelay()));
+        }
+    }
+}
+
+bool SimulationManager::toggleProbe(Component* component) {
+    GateId gate = getGateId(component);
+    if (gate == INVALID_GATE) return false;
+    auto lock = simulationThread.Lock();
+    Netlist& netlist = simulator.GetNetlist();
+    netlist.SetProbed(gate, !netlist.IsProbed(gate));
+    return netlist.IsProbed(gate);
+}
+
+bool SimulationManager::toggleFixedInput(Component* component) {
+    GateId gate = getGateId(component);
+    if (gate == INVALID_GATE) return false;
+    auto lock = simulationThread.Lock();
+    Netlist& netlist = simulator.GetNetlist();
+    netlist.SetInputFixed(gate, !netlist.IsInputFixed(gate));
+    return netlist.IsInputFixed(gate);
+}
+
+void SimulationManager::start() {
+    simulationThread.Start();
+}
+
+void SimulationManager::stop() {
+    simulationThread.Stop();
+}
+
+void SimulationManager::update() {
+    if (task.valid() && task.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        taskMessage = task.get();
+        std::cout << taskMessage << std::endl;
+    }
+    status.taskMessage = taskMessage;
+
+    auto lock = simulationThread.Lock();
+    syncComponentStates();
+    syncTimingSignals();
+
+    status.engineName = simulator.GetEngineName();
+    status.tick = simulator.GetTick();
+    status.tickRate = simulationThread.GetTickRate();
+    status.achievedTickRate = simulationThread.GetAchievedTickRate();
+    status.paused = simulationThread.IsPaused();
+    status.historyFirstTick = simulator.GetHistory().GetFirstTick();
+    status.dumping = waveformWriter != nullptr;
+    status.droppedDumpTicks = waveformWriter ? waveformWriter->GetDroppedTickCount() : 0;
+    status.timingView = timingPyramid != nullptr;
+    status.timingWindow = timingWindow;
+}
+
+void SimulationManager::togglePause() {
+    simulationThread.SetPaused(!simulationThread.IsPaused());
+}
+
+void SimulationManager::stepOnce() {
+    if (!simulationThread.IsPaused()) return;
+    auto lock = simulationThread.Lock();
+    simulator.Step();
+}
+
+void SimulationManager::stepBack() {
+    if (!simulationThread.IsPaused()) return;
+    auto lock = simulationThread.Lock();
+    if (simulator.GetTick() > 0) {
+        simulator.Seek(simulator.GetTick() - 1);
+    }
+}
+
+void SimulationManager::scaleTickRate(double factor) {
+    limitedTickRate = std::clamp(limitedTickRate * factor, MIN_TICK_RATE, MAX_TICK_RATE);
+    simulationThread.SetTickRate(limitedTickRate);
+}
+
+void SimulationManager::toggleUnlimitedTickRate() {
+    if (simulationThread.GetTickRate() == SimulationThread::UNLIMITED) {
+        simulationThread.SetTickRate(limitedTickRate);
+    } else {
+        simulationThread.SetTickRate(SimulationThread::UNLIMITED);
+    }
+}
+
+bool SimulationManager::toggleWaveformDump(const std::string& path, std::string& error) {
+    if (waveformWriter) {
+        {
+            auto lock = simulationThread.Lock();
+            simulator.RemoveWaveformSink(waveformWriter.get());
+        }
+        // Flushing happens outside the lock
+        waveformWriter.reset();
+        return false;
+    }
+
+    std::unique_ptr<WaveformWriter> writer;
+    if (path.ends_with(".vcd")) {
+        writer = std::make_unique<VcdWriter>();
+    } else {
+        writer = std::make_unique<TraceWriter>();
+    }
+    auto lock = simulationThread.Lock();
+    const Netlist& netlist = simulator.GetNetlist();
+    std::vector<NetId> nets;
+    for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+        if (netlist.IsValidGate(gate) && netlist.IsProbed(gate)) nets.push_back(netlist.GetOutput(gate));
+    }
+    if (!writer->Open(path, netlist, nets, simulator.GetTick(), error)) return false;
+    waveformWriter = std::move(writer);
+    simulator.AddWaveformSink(waveformWriter.get());
+    return true;
+}
+
+void SimulationManager::toggleTimingView() {
+    auto lock = simulationThread.Lock();
+    if (timingPyramid) {
+        simulator.RemoveWaveformSink(timingPyramid.get());
+        timingPyramid.reset();
+        return;
+    }
+    timingPyramid = std::make_unique<WaveformPyramid>();
+    simulator.AddWaveformSink(timingPyramid.get());
+    timingVersion = UINT64_MAX;
+    syncTimingSignals();
+}
+
+void SimulationManager::scaleTimingWindow(double factor) {
+    double window = std::clamp(static_cast<double>(timingWindow) * factor, static_cast<double>(MIN_TIMING_WINDOW),
+                               static_cast<double>(MAX_TIMING_WINDOW));
+    timingWindow = static_cast<uint64_t>(window);
+}
+
+bool SimulationManager::sampleTimingDiagram(size_t columns, TimingDiagram& diagram) {
+    auto lock = simulationThread.Lock();
+    if (!timingPyramid) return false;
+
+    const Netlist& netlist = simulator.GetNetlist();
+    const std::vector<NetId>& nets = timingPyramid->GetNets();
+    diagram.end = timingPyramid->GetLastTick() + 1;
+    diagram.begin = diagram.end > timingWindow ? diagram.end - timingWindow : 0;
+    diagram.names.resize(nets.size());
+    diagram.rows.resize(nets.size());
+    for (uint32_t signal = 0; signal < nets.size(); ++signal) {
+        GateId gate = netlist.GetDriver(nets[signal]);
+        diagram.names[signal] = std::string(GetGateKindName(netlist.GetKind(gate))) + "_" + std::to_string(gate);
+        timingPyramid->Sample(signal, diagram.begin, diagram.end, columns, diagram.rows[signal]);
+    }
+    return true;
+}
+
+void SimulationManager::cycleEngine() {
+    static const EngineKind engines[] = {
+        EngineKind::EVENT_DRIVEN,
+        EngineKind::LEVELIZED,
+        EngineKind::BYTECODE,
+        EngineKind::SCC,
+        EngineKind::TIMED,
+        EngineKind::OPTIMIZED,
+        EngineKind::AIG,
+        EngineKind::BIT_PARALLEL,
+        EngineKind::ISLAND_PARALLEL,
+        EngineKind::LEVEL_PARALLEL,
+        EngineKind::SWEEP
+    };
+    const int count = sizeof(engines) / sizeof(engines[0]);
+
+    auto lock = simulationThread.Lock();
+    int current = 0;
+    for (int i = 0; i < count; ++i) {
+        if (engines[i] == simulator.GetEngineKind()) current = i;
+    }
+    simulator.SetEngine(engines[(current + 1) % count]);
+}
+
+void SimulationManager::compileCircuit() {
+    // The native engine builds in the background and interprets until then
+    auto lock = simulationThread.Lock();
+    if (simulator.GetEngineKind() != EngineKind::NATIVE) {
+        simulator.SetEngine(EngineKind::NATIVE);
+    }
+}
+
+bool SimulationManager::startTask(const std::string& description, std::function<std::string()> work, std::string& error) {
+    if (task.valid()) {
+        error = "another export is still running";
+        return false;
+    }
+    taskMessage = description + "...";
+    task = std::async(std::launch::async, std::move(work));
+    return true;
+}
+
+bool SimulationManager::exportTruthTable(Component* root, const std::string& path, std::string& error) {
+    // Enumerate a copy so the simulation keeps running meanwhile
+    auto netlist = std::make_shared<Netlist>();
+    std::vector<GateId> selection;
+    {
+        auto lock = simulationThread.Lock();
+        *netlist = simulator.GetNetlist();
+        GateId rootGate = root ? getGateId(root) : INVALID_GATE;
+        if (root && rootGate == INVALID_GATE) {
+            error = "component is not simulated";
+            return false;
+        }
+        if (rootGate != INVALID_GATE) {
+            // Fanin cone of the root
+            std::vector<uint8_t> visited(netlist->GetGateCount(), 0);
+            selection.push_back(rootGate);
+            visited[rootGate] = 1;
+            for (size_t i = 0; i < selection.size(); ++i) {
+                for (NetId net : netlist->GetFanin(selection[i])) {
+                    GateId driver = netlist->GetDriver(net);
+                    if (driver != INVALID_GATE && !visited[driver]) {
+                        visited[driver] = 1;
+                        selection.push_back(driver);
+                    }
+                }
+            }
+        }
+    }
+
+    return startTask("Writing truth table to " + path, [netlist, selection = std::move(selection), path]() -> std::string {
+        TruthTable table;
+        std::string error;
+        if (!GenerateTruthTable(*netlist, selection, table, error)) return "Truth table failed: " + error;
+        std::ofstream file(path);
+        if (!file) return "Truth table failed: cannot write " + path;
+        if (table.GetRowCount() <= MAX_TRUTH_TABLE_CSV_ROWS) {
+            WriteTruthTableCsv(table, file);
+        } else {
+            WriteTruthTableWordsCsv(table, file);
+        }
+        return "Truth table written to " + path;
+    }, error);
+}
+
+bool SimulationManager::exportFaultReport(const std::string& stimulusPath, const std::string& reportPath, std::string& error) {
+    auto netlist = std::make_shared<Netlist>();
+    std::vector<GateId> inputs;
+    {
+        auto lock = simulationThread.Lock();
+        *netlist = simulator.GetNetlist();
+    }
+    // Stimulus columns follow the switches in placement order
+    for (Component* component : ComponentManager::getInstance().getComponents()) {
+        GateId gate = getGateId(component);
+        if (gate != INVALID_GATE && netlist->GetKind(gate) == GateKind::INPUT) inputs.push_back(gate);
+    }
+
+    return startTask("Grading faults into " + reportPath, [netlist, inputs = std::move(inputs), stimulusPath, reportPath]() -> std::string {
+        std::vector<std::vector<uint8_t>> patterns;
+        std::ifstream stimulus(stimulusPath);
+        if (stimulus) {
+            std::string line;
+            while (std::getline(stimulus, line)) {
+                std::vector<uint8_t> pattern;
+                for (char c : line) {
+                    if (c == '0' || c == '1') pattern.push_back(static_cast<uint8_t>(c - '0'));
+                }
+                if (!pattern.empty()) patterns.push_back(std::move(pattern));
+            }
+        } else {
+            if (inputs.size() > MAX_EXHAUSTIVE_FAULT_INPUTS) {
+                return "Fault simulation failed: no " + stimulusPath + " and too many switches to try every combination";
+            }
+            for (uint32_t row = 0; row < (1u << inputs.size()); ++row) {
+                std::vector<uint8_t>& pattern = patterns.emplace_back(inputs.size());
+                for (size_t input = 0; input < inputs.size(); ++input) pattern[input] = (row >> input) & 1;
+            }
+        }
+
+        FaultReport report;
+        std::string error;
+        if (!SimulateFaults(*netlist, inputs, patterns, report, error)) return "Fault simulation failed: " + error;
+        std::ofstream file(reportPath);
+        if (!file) return "Fault simulation failed: cannot write " + reportPath;
+        WriteFaultReport(report, file);
+        return "Fault report written to " + reportPath;
+    }, error);
+}
+
+void SimulationManager::syncTimingSignals() {
+    if (!timingPyramid) return;
+    // The watched set only moves with edits; probe toggles count as edits too
+    const Netlist& netlist = simulator.GetNetlist();
+    if (netlist.GetTopologyVersion() == timingVersion && netlist.GetProbeCount() == timingProbeCount) return;
+    timingVersion = netlist.GetTopologyVersion();
+    timingProbeCount = netlist.GetProbeCount();
+
+    bool probed = netlist.GetProbeCount() != 0;
+    std::vector<NetId> nets;
+    for (GateId gate = 0; gate < netlist.GetGateCount() && nets.size() < MAX_TIMING_SIGNALS; ++gate) {
+        if (netlist.IsValidGate(gate) && (!probed || netlist.IsProbed(gate))) nets.push_back(netlist.GetOutput(gate));
+    }
+    if (nets != timingPyramid->GetNets()) {
+        timingPyramid->Reset(netlist, nets, simulator.GetTick());
+    }
+}
+
+GateId SimulationManager::getGateId(Component* component) const {
+    auto it = gateIds.find(component);
+    return it != gateIds.end() ? it->second : INVALID_GATE;
+}
+
+GateId SimulationManager::getOutputGate(Component* component, int output) const {
+    GateId gate = getGateId(component);
+    if (gate == INVALID_GATE) return INVALID_GATE;
+    const Netlist& netlist = simulator.GetNetlist();
+    SubcircuitId instance = netlist.GetSubcircuitOf(gate);
+    return instance == INVALID_SUBCIRCUIT ? gate : netlist.GetSubcircuitPorts(instance)[output];
+}
+
+bool SimulationManager::resolveWire(const Wire* wire, GateId& driver, GateId& reader, int& readerPin) const {
+    // Wires may be drawn in either direction; find the output pin that drives the input pin
+    Component* start = wire->GetStartComponent();
+    Component* end = wire->GetEndComponent();
+    int startPin = wire->GetStartPinIndex();
+    int endPin = wire->GetEndPinIndex();
+
+    bool startIsOutput = startPin >= start->GetNumInputs();
+    bool endIsOutput = endPin >= end->GetNumInputs();
+    if (startIsOutput == endIsOutput) return false;
+
+    if (startIsOutput) {
+        driver = getOutputGate(start, startPin - start->GetNumInputs());
+        reader = getGateId(end);
+        readerPin = endPin;
+    } else {
+        driver = getOutputGate(end, endPin - end->GetNumInputs());
+        reader = getGateId(start);
+        readerPin = startPin;
+    }
+    return driver != INVALID_GATE && reader != INVALID_GATE;
+}
+
+void SimulationManager::syncComponentStates() {
+    const Netlist& netlist = simulator.GetNetlist();
+    for (const auto& [component, gate] : gateIds) {
+        // Subcircuit ports also read the instance's state bits
+        std::span<const NetId> fanin = netlist.GetFanin(gate);
+        for (int pin = 0; pin < component->GetNumInputs(); ++pin) {
+            component->SetInputState(pin, netlist.GetNetValue(fanin[pin]));
+        }
+        SubcircuitId instance = netlist.GetSubcircuitOf(gate);
+        for (int output = 0; output < component->GetNumOutputs(); ++output) {
+            GateId driver = instance == INVALID_SUBCIRCUIT ? gate : netlist.GetSubcircuitPorts(instance)[output];
+            component->SetOutputState(output, netlist.GetNetValue(netlist.GetOutput(driver)));
+        }
+    }
+}
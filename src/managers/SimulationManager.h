@@ -0,0 +1,140 @@
+#ifndef SIMULATION_MANAGER_H
+#define SIMULATION_MANAGER_H
+
+#include "../simulation/Simulator.h"
+#include "../simulation/SimulationThread.h"
+#include "../simulation/WaveformPyramid.h"
+#include "../simulation/WaveformWriter.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Component;
+class Wire;
+
+// Snapshot of the simulation taken once per frame for display
+struct SimulationStatus {
+    const char* engineName = "";
+    uint64_t tick = 0;
+    double tickRate = 0.0;
+    double achievedTickRate = 0.0;
+    bool paused = false;
+    uint64_t historyFirstTick = 0;
+    bool dumping = false;
+    uint64_t droppedDumpTicks = 0;
+    bool timingView = false;
+    uint64_t timingWindow = 0;
+    // Progress or outcome of the latest background export
+    std::string taskMessage;
+};
+
+// Watched signals over the latest ticks, one summary per screen column
+struct TimingDiagram {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    std::vector<std::string> names;
+    std::vector<std::vector<PyramidSummary>> rows;
+};
+
+// Mirrors editor components and wires into the headless simulator, which
+// runs on its own thread, and copies simulated values back onto the
+// components once per frame for drawing.
+class SimulationManager {
+public:
+    static SimulationManager& getInstance();
+
+    void addComponent(Component* component);
+    void removeComponent(Component* component);
+    void addWire(Wire* wire);
+    void removeWire(Wire* wire);
+    void setInputValue(Component* component, bool value);
+    void setDelay(Component* component, int delay);
+    // Optimizer hints; both return the new setting
+    bool toggleProbe(Component* component);
+    bool toggleFixedInput(Component* component);
+
+    void start();
+    void stop();
+    void update();
+
+    // Starts or stops dumping the probed nets, or every net without probes;
+    // a .vcd path writes a Value Change Dump, anything else a binary trace.
+    // Returns whether a dump is running afterwards.
+    bool toggleWaveformDump(const std::string& path, std::string& error);
+
+    // The timing view follows the probed gates, or the first few gates
+    // without probes, from the moment it is opened
+    void toggleTimingView();
+    void scaleTimingWindow(double factor);
+    // False while the timing view is closed
+    bool sampleTimingDiagram(size_t columns, TimingDiagram& diagram);
+
+    void cycleEngine();
+    void compileCircuit();
+    // Exports run on a background task, one at a time, and report back
+    // through SimulationStatus::taskMessage; they return false when the
+    // export cannot start.
+    // Writes the truth table of the logic feeding a component, or of the
+    // whole sheet when none is given, as CSV (64 rows per line for large tables)
+    bool exportTruthTable(Component* root, const std::string& path, std::string& error);
+    // Grades the stimulus in stimulusPath (one line of 0/1 per pattern, one
+    // character per input switch in the order the switches were placed)
+    // against every stuck-at fault; without the file, circuits with few
+    // switches try every combination
+    bool exportFaultReport(const std::string& stimulusPath, const std::string& reportPath, std::string& error);
+    void togglePause();
+    void stepOnce();
+    void stepBack();
+    void scaleTickRate(double factor);
+    void toggleUnlimitedTickRate();
+
+    const SimulationStatus& getStatus() const { return status; }
+
+    // Hold lock() while touching the simulator from outside the manager
+    Simulator& getSimulator() { return simulator; }
+    std::unique_lock<std::mutex> lock() { return simulationThread.Lock(); }
+
+private:
+    SimulationManager();
+    ~SimulationManager() = default;
+    SimulationManager(const SimulationManager&) = delete;
+    SimulationManager& operator=(const SimulationManager&) = delete;
+
+    GateId getGateId(Component* component) const;
+    // Gate driving an output pin; each subcircuit output is its own port gate
+    GateId getOutputGate(Component* component, int output) const;
+    bool resolveWire(const Wire* wire, GateId& driver, GateId& reader, int& readerPin) const;
+    void syncComponentStates();
+    void syncTimingSignals();
+    // Runs task off the render thread; its result replaces the task message
+    bool startTask(const std::string& description, std::function<std::string()> task, std::string& error);
+
+    static constexpr double DEFAULT_TICK_RATE = 60.0;
+    static constexpr double MIN_TICK_RATE = 1.0;
+    static constexpr double MAX_TICK_RATE = 10000000.0;
+    static constexpr size_t MAX_EXHAUSTIVE_FAULT_INPUTS = 16;
+    static constexpr size_t MAX_TIMING_SIGNALS = 16;
+    static constexpr uint64_t DEFAULT_TIMING_WINDOW = 256;
+    static constexpr uint64_t MIN_TIMING_WINDOW = 16;
+    static constexpr uint64_t MAX_TIMING_WINDOW = uint64_t(1) << 40;
+
+    Simulator simulator;
+    SimulationThread simulationThread;
+    SimulationStatus status;
+    double limitedTickRate = DEFAULT_TICK_RATE;
+    std::unordered_map<Component*, GateId> gateIds;
+    std::unique_ptr<WaveformWriter> waveformWriter;
+    std::unique_ptr<WaveformPyramid> timingPyramid;
+    uint64_t timingWindow = DEFAULT_TIMING_WINDOW;
+    // Netlist state the timing signals were last chosen from
+    uint64_t timingVersion = UINT64_MAX;
+    size_t timingProbeCount = 0;
+    std::future<std::string> task;
+    std::string taskMessage;
+};
+
+#endif // SIMULATION_MANAGER_H
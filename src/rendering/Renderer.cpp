@@ -2,6 +2,7 @@
 #include "../core/Component.h"
 #include "../circuit_elements/Wire.h"
 #include "../managers/ComponentManager.h"
+#include "../managers/SimulationManager.h"
 #include "../core/GameState.h"
 #include "../core/Grid.h"
 #include <raymath.h>
@@ -122,6 +123,8 @@ void Renderer::Render(ProgramState currentState, Component* wireStartComponent,
     EndMode2D();
     
     DrawToolbar(currentComponentType);
+    DrawTimingDiagram();
+    DrawTaskMessage();
     
     if (showDebugInfo) {
         DrawDebugInfo(currentState, currentComponentType, placementRotation, mousePosition, worldMousePos);
@@ -137,14 +140,14 @@ void Renderer::DrawGrid() {
 }
 
 void Renderer::DrawToolbar(ComponentType currentComponentType) {
-    int buttonWidth = m_screenWidth / 4;
+    int buttonWidth = m_screenWidth / 6;
     int fontSize = static_cast<int>(20 * m_globalScaleFactor);
     
     DrawRectangle(0, 0, m_screenWidth, m_toolbarHeight, LIGHTGRAY);
     
-    const char* buttonTexts[] = {"AND (A)", "OR (O)", "NOT (N)", "INPUT (I)"};
+    const char* buttonTexts[] = {"AND (A)", "OR (O)", "NOT (N)", "INPUT (I)", "XOR (X)", "ADDER (S)"};
     
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < 6; i++) {
         DrawRectangleLines(buttonWidth * i, 0, buttonWidth, m_toolbarHeight, BLACK);
         int textWidth = MeasureText(buttonTexts[i], fontSize);
         int textX = buttonWidth * i + (buttonWidth - textWidth) / 2;
@@ -157,6 +160,52 @@ void Renderer::DrawToolbar(ComponentType currentComponentType) {
     DrawRectangle(buttonWidth * selectedButton, 0, buttonWidth, m_toolbarHeight, Fade(YELLOW, 0.5f));
 }
 
+void Renderer::DrawTimingDiagram() {
+    // One summary per pixel column, however many ticks the window spans
+    static TimingDiagram diagram;
+    int plotWidth = m_screenWidth - TIMING_LABEL_WIDTH - 10;
+    if (plotWidth <= 0 || !SimulationManager::getInstance().sampleTimingDiagram(plotWidth, diagram)) return;
+
+    int fontSize = 16;
+    int height = static_cast<int>(diagram.rows.size() + 1) * TIMING_ROW_HEIGHT;
+    int top = m_screenHeight - height;
+    DrawRectangle(0, top, m_screenWidth, height, Fade(RAYWHITE, 0.9f));
+    DrawLine(0, top, m_screenWidth, top, DARKGRAY);
+    DrawText(TextFormat("Ticks %llu - %llu", static_cast<unsigned long long>(diagram.begin),
+                        static_cast<unsigned long long>(diagram.end)), 10, top + 4, fontSize, DARKGRAY);
+
+    for (size_t row = 0; row < diagram.rows.size(); ++row) {
+        int rowTop = top + static_cast<int>(row + 1) * TIMING_ROW_HEIGHT;
+        int highY = rowTop + 4;
+        int lowY = rowTop + TIMING_ROW_HEIGHT - 4;
+        DrawText(diagram.names[row].c_str(), 10, rowTop + 4, fontSize, BLACK);
+
+        const std::vector<PyramidSummary>& samples = diagram.rows[row];
+        for (int column = 0; column < static_cast<int>(samples.size()); ++column) {
+            const PyramidSummary& sample = samples[column];
+            if (sample.IsEmpty()) continue;
+            int x = TIMING_LABEL_WIDTH + column;
+            // An edge, or toggling faster than a pixel resolves
+            if (sample.transitions != 0) {
+                DrawLine(x, highY, x, lowY, DARKGREEN);
+            }
+            if (sample.low == sample.high) {
+                int y = sample.high ? highY : lowY;
+                DrawLine(x, y, x + 1, y, DARKGREEN);
+            }
+        }
+    }
+}
+
+void Renderer::DrawTaskMessage() {
+    // Outcome of the latest export, centred under the toolbar
+    const std::string& message = SimulationManager::getInstance().getStatus().taskMessage;
+    if (message.empty()) return;
+    int fontSize = static_cast<int>(20 * m_globalScaleFactor);
+    int textWidth = MeasureText(message.c_str(), fontSize);
+    DrawText(message.c_str(), (m_screenWidth - textWidth) / 2, m_toolbarHeight + 10, fontSize, DARKBLUE);
+}
+
 void Renderer::DrawDebugInfo(ProgramState currentState, ComponentType currentComponentType, float placementRotation, Vector2 mousePosition, Vector2 worldMousePos) {
     int screenWidth = GetScreenWidth();
     int screenHeight = GetScreenHeight();
@@ -178,11 +227,25 @@ void Renderer::DrawDebugInfo(ProgramState currentState, ComponentType currentCom
     DrawText(TextFormat("Current Component: %s", 
         currentComponentType == ComponentType::AND ? "AND" : 
         currentComponentType == ComponentType::OR ? "OR" : 
-        currentComponentType == ComponentType::NOT ? "NOT" : "INPUT"), 10, m_toolbarHeight + 10 + 4 * lineHeight, fontSize, DARKGRAY);
+        currentComponentType == ComponentType::NOT ? "NOT" :
+        currentComponentType == ComponentType::XOR ? "XOR" :
+        currentComponentType == ComponentType::FULL_ADDER ? "FULL ADDER" : "INPUT"), 10, m_toolbarHeight + 10 + 4 * lineHeight, fontSize, DARKGRAY);
     DrawText(TextFormat("Camera Zoom: %.2f", m_camera.zoom), 10, m_toolbarHeight + 10 + 5 * lineHeight, fontSize, DARKGRAY);
     DrawText(TextFormat("Camera Target: (%.2f, %.2f)", m_camera.target.x, m_camera.target.y), 10, m_toolbarHeight + 10 + 6 * lineHeight, fontSize, DARKGRAY);
     DrawText(TextFormat("Placement Rotation: %.2f", placementRotation), 10, m_toolbarHeight + 10 + 7 * lineHeight, fontSize, DARKGRAY);
     DrawText(TextFormat("Debug Frames: %s", Component::AreDebugFramesEnabled() ? "ON" : "OFF"), 10, m_toolbarHeight + 10 + 8 * lineHeight, fontSize, DARKGRAY);
+    const SimulationStatus& simStatus = SimulationManager::getInstance().getStatus();
+    DrawText(TextFormat("Engine: %s", simStatus.engineName), 10, m_toolbarHeight + 10 + 9 * lineHeight, fontSize, DARKGRAY);
+    DrawText(TextFormat("Tick: %llu%s", static_cast<unsigned long long>(simStatus.tick), simStatus.paused ? " (paused)" : ""), 10, m_toolbarHeight + 10 + 10 * lineHeight, fontSize, DARKGRAY);
+    if (simStatus.tickRate == SimulationThread::UNLIMITED) {
+        DrawText(TextFormat("Ticks/s: %.0f (unlimited)", simStatus.achievedTickRate), 10, m_toolbarHeight + 10 + 11 * lineHeight, fontSize, DARKGRAY);
+    } else {
+        DrawText(TextFormat("Ticks/s: %.0f (target %.0f)", simStatus.achievedTickRate, simStatus.tickRate), 10, m_toolbarHeight + 10 + 11 * lineHeight, fontSize, DARKGRAY);
+    }
+    DrawText(TextFormat("History from tick: %llu", static_cast<unsigned long long>(simStatus.historyFirstTick)), 10, m_toolbarHeight + 10 + 12 * lineHeight, fontSize, DARKGRAY);
+    if (simStatus.dumping) {
+        DrawText(TextFormat("Dumping waveforms (%llu ticks dropped)", static_cast<unsigned long long>(simStatus.droppedDumpTicks)), 10, m_toolbarHeight + 10 + 13 * lineHeight, fontSize, DARKGRAY);
+    }
 
     // Right side debug info
     DrawText(TextFormat("Screen Mouse: (%.1f, %.1f)", mousePosition.x, mousePosition.y), rightAlignX, m_toolbarHeight + 10, fontSize, DARKGRAY);
@@ -26,6 +26,8 @@ public:
 private:
     void DrawGrid();
     void DrawToolbar(ComponentType currentComponentType);
+    void DrawTimingDiagram();
+    void DrawTaskMessage();
     void DrawDebugInfo(ProgramState currentState, ComponentType currentComponentType, float placementRotation, Vector2 mousePosition, Vector2 worldMousePos);
     void DrawRotatedComponent(const Component* component);
     void DrawRotatedRectangleLinesEx(Rectangle rec, float rotation, float lineThick, Color color);
@@ -49,4 +51,6 @@ private:
     static constexpr float MAX_ZOOM = 2.0f;
     static constexpr float PIN_RADIUS = 5.0f;
     static constexpr float CONNECTION_RADIUS = 20.0f;
+    static constexpr int TIMING_ROW_HEIGHT = 24;
+    static constexpr int TIMING_LABEL_WIDTH = 100;
 };
@@ -0,0 +1,142 @@
+#include "Aig.h"
+#include "StronglyConnected.h"
+#include "Subcircuit.h"
+#include <algorithm>
+
+Aig::Aig() {
+    nodes.push_back({ AIG_FALSE, AIG_FALSE });
+}
+
+AigLiteral Aig::AddInput() {
+    nodes.push_back({ AIG_INPUT, AIG_INPUT });
+    ++inputCount;
+    return static_cast<AigLiteral>((nodes.size() - 1) << 1);
+}
+
+AigLiteral Aig::And(AigLiteral a, AigLiteral b) {
+    if (a > b) std::swap(a, b);
+    if (a == AIG_FALSE) return AIG_FALSE;
+    if (a == AIG_TRUE) return b;
+    if (a == b) return a;
+    if (a == AigNot(b)) return AIG_FALSE;
+
+    uint64_t key = static_cast<uint64_t>(a) << 32 | b;
+    auto [it, inserted] = structuralHash.try_emplace(key, static_cast<uint32_t>(nodes.size()));
+    if (inserted) {
+        nodes.push_back({ a, b });
+    }
+    return it->second << 1;
+}
+
+AigLiteral Aig::AndAll(std::vector<AigLiteral> literals) {
+    if (literals.empty()) return AIG_TRUE;
+    while (literals.size() > 1) {
+        size_t half = 0;
+        for (size_t i = 0; i + 1 < literals.size(); i += 2) {
+            literals[half++] = And(literals[i], literals[i + 1]);
+        }
+        if (literals.size() % 2) {
+            literals[half++] = literals.back();
+        }
+        literals.resize(half);
+    }
+    return literals[0];
+}
+
+AigLiteral Aig::OrAll(std::vector<AigLiteral> literals) {
+    for (AigLiteral& literal : literals) literal = AigNot(literal);
+    return AigNot(AndAll(std::move(literals)));
+}
+
+AigLiteral Aig::XorAll(std::vector<AigLiteral> literals) {
+    if (literals.empty()) return AIG_FALSE;
+    while (literals.size() > 1) {
+        size_t half = 0;
+        for (size_t i = 0; i + 1 < literals.size(); i += 2) {
+            literals[half++] = Xor(literals[i], literals[i + 1]);
+        }
+        if (literals.size() % 2) {
+            literals[half++] = literals.back();
+        }
+        literals.resize(half);
+    }
+    return literals[0];
+}
+
+void Aig::Simulate(uint64_t* words) const {
+    words[0] = 0;
+    const AigNode* node = nodes.data();
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        if (node[i].fanin0 == AIG_INPUT) continue;
+        words[i] = LiteralWord(words, node[i].fanin0) & LiteralWord(words, node[i].fanin1);
+    }
+}
+
+AigLiteral LowerGateToAig(Aig& aig, const Netlist& netlist, GateId gate, const std::vector<AigLiteral>& netLiterals) {
+    std::vector<AigLiteral> operands;
+    for (NetId net : netlist.GetFanin(gate)) {
+        operands.push_back(netLiterals[net]);
+    }
+    switch (netlist.GetKind(gate)) {
+        case GateKind::AND:
+            return operands.empty() ? AIG_FALSE : aig.AndAll(std::move(operands));
+        case GateKind::OR:
+            return aig.OrAll(std::move(operands));
+        case GateKind::NOT:
+            return AigNot(operands[0]);
+        case GateKind::XOR:
+            return aig.XorAll(std::move(operands));
+        case GateKind::SUBCIRCUIT:
+            return netlist.GetSubcircuitDefinition(netlist.GetSubcircuitOf(gate))
+                .LowerPort(aig, operands.data(), netlist.GetSubcircuitPort(gate));
+        case GateKind::INPUT:
+        case GateKind::NONE:
+            break;
+    }
+    return AIG_FALSE;
+}
+
+AigNetlist LowerToAig(const Netlist& netlist) {
+    AigNetlist result;
+    Aig& aig = result.aig;
+    std::vector<AigLiteral>& netLiterals = result.netLiterals;
+    netLiterals.assign(netlist.GetNetCount(), AIG_INPUT);
+    netLiterals[Netlist::CONST0] = AIG_FALSE;
+    netLiterals[Netlist::CONST1] = AIG_TRUE;
+
+    // Components come sources first, so every driver is lowered before its readers
+    SccDecomposition components = FindStronglyConnectedComponents(netlist);
+    for (size_t component = 0; component < components.GetComponentCount(); ++component) {
+        const GateId* begin = components.gates.data() + components.componentOffsets[component];
+        const GateId* end = components.gates.data() + components.componentOffsets[component + 1];
+
+        if (!components.componentCyclic[component]) {
+            GateId gate = *begin;
+            if (netlist.GetKind(gate) == GateKind::INPUT) {
+                AigLiteral input = aig.AddInput();
+                result.inputs.push_back({ gate, AigNodeOf(input) });
+                netLiterals[netlist.GetOutput(gate)] = input;
+            } else {
+                netLiterals[netlist.GetOutput(gate)] = LowerGateToAig(aig, netlist, gate, netLiterals);
+            }
+            continue;
+        }
+
+        // Inside a loop gates read each other's previous values; readers
+        // outside it see the newly computed ones
+        for (const GateId* gate = begin; gate != end; ++gate) {
+            NetId output = netlist.GetOutput(*gate);
+            AigLiteral cut = aig.AddInput();
+            result.loopCuts.push_back({ output, AigNodeOf(cut) });
+            netLiterals[output] = cut;
+        }
+        std::vector<AigLiteral> loopLiterals;
+        for (const GateId* gate = begin; gate != end; ++gate) {
+            loopLiterals.push_back(LowerGateToAig(aig, netlist, *gate, netLiterals));
+        }
+        for (const GateId* gate = begin; gate != end; ++gate) {
+            netLiterals[netlist.GetOutput(*gate)] = loopLiterals[gate - begin];
+        }
+    }
+    return result;
+}
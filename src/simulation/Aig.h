@@ -0,0 +1,82 @@
+#ifndef AIG_H
+#define AIG_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Edge into an And-Inverter Graph: node index << 1, low bit set when the
+// edge is complemented
+using AigLiteral = uint32_t;
+
+// Two-input AND node. Input nodes have both fanins set to AIG_INPUT.
+struct AigNode {
+    AigLiteral fanin0;
+    AigLiteral fanin1;
+};
+static_assert(sizeof(AigNode) == 8, "AIG nodes are meant to stay 8 bytes");
+
+constexpr AigLiteral AIG_FALSE = 0;
+constexpr AigLiteral AIG_TRUE = 1;
+constexpr AigLiteral AIG_INPUT = UINT32_MAX;
+
+inline AigLiteral AigNot(AigLiteral literal) { return literal ^ 1; }
+inline uint32_t AigNodeOf(AigLiteral literal) { return literal >> 1; }
+inline bool AigIsComplemented(AigLiteral literal) { return (literal & 1) != 0; }
+
+// And-Inverter Graph: every gate lowered to two-input ANDs with optionally
+// inverted edges. Node 0 is constant false. Structurally identical ANDs are
+// shared (hash-consing), trivial ones simplify away, and every node comes
+// after its fanins, so one pass in index order evaluates the graph.
+class Aig {
+public:
+    Aig();
+
+    AigLiteral AddInput();
+    AigLiteral And(AigLiteral a, AigLiteral b);
+    AigLiteral Or(AigLiteral a, AigLiteral b) { return AigNot(And(AigNot(a), AigNot(b))); }
+    AigLiteral Xor(AigLiteral a, AigLiteral b) { return Or(And(a, AigNot(b)), And(AigNot(a), b)); }
+    // Balanced trees over any number of operands
+    AigLiteral AndAll(std::vector<AigLiteral> literals);
+    AigLiteral OrAll(std::vector<AigLiteral> literals);
+    AigLiteral XorAll(std::vector<AigLiteral> literals);
+
+    const std::vector<AigNode>& GetNodes() const { return nodes; }
+    size_t GetNodeCount() const { return nodes.size(); }
+    size_t GetAndCount() const { return nodes.size() - 1 - inputCount; }
+    size_t GetInputCount() const { return inputCount; }
+    bool IsInput(uint32_t node) const { return nodes[node].fanin0 == AIG_INPUT; }
+
+    // 64 patterns at once: words holds one word per node, with the input
+    // nodes filled in by the caller; every AND node is overwritten
+    void Simulate(uint64_t* words) const;
+    static uint64_t LiteralWord(const uint64_t* words, AigLiteral literal) {
+        return words[AigNodeOf(literal)] ^ (uint64_t(0) - (literal & 1));
+    }
+
+private:
+    std::vector<AigNode> nodes;
+    std::unordered_map<uint64_t, uint32_t> structuralHash;
+    size_t inputCount = 0;
+};
+
+// A netlist lowered to an AIG. Gates in combinational loops are cut: each
+// reads the loop's nets as extra inputs holding their previous values.
+struct AigNetlist {
+    Aig aig;
+    // Literal computing each net's value, AIG_INPUT for unused slots
+    std::vector<AigLiteral> netLiterals;
+    // Netlist INPUT gate -> AIG input node
+    std::vector<std::pair<GateId, uint32_t>> inputs;
+    // Net of a loop gate -> AIG input node standing in for its previous value
+    std::vector<std::pair<NetId, uint32_t>> loopCuts;
+};
+
+AigNetlist LowerToAig(const Netlist& netlist);
+
+// Lowers one gate given the literals of the nets it reads
+AigLiteral LowerGateToAig(Aig& aig, const Netlist& netlist, GateId gate, const std::vector<AigLiteral>& netLiterals);
+
+#endif // AIG_H
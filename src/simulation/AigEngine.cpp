@@ -0,0 +1,27 @@
+#include "AigEngine.h"
+
+void AigEngine::Step(Netlist& netlist) {
+    if (loweredVersion != netlist.GetTopologyVersion()) {
+        lowered = LowerToAig(netlist);
+        words.assign(lowered.aig.GetNodeCount(), 0);
+        loweredVersion = netlist.GetTopologyVersion();
+    }
+
+    // Every lane carries the same pattern; lane 0 is read back
+    for (const auto& [gate, node] : lowered.inputs) {
+        words[node] = netlist.GetInputValue(gate) ? ~uint64_t(0) : 0;
+    }
+    for (const auto& [net, node] : lowered.loopCuts) {
+        words[node] = netlist.GetNetValue(net) ? ~uint64_t(0) : 0;
+    }
+    lowered.aig.Simulate(words.data());
+
+    uint8_t* values = netlist.GetValueData();
+    for (NetId net = Netlist::CONST1 + 1; net < lowered.netLiterals.size(); ++net) {
+        AigLiteral literal = lowered.netLiterals[net];
+        if (literal != AIG_INPUT) {
+            values[net] = static_cast<uint8_t>(Aig::LiteralWord(words.data(), literal) & 1);
+        }
+    }
+    netlist.ClearDirtyGates();
+}
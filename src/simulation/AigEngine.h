@@ -0,0 +1,26 @@
+#ifndef AIG_ENGINE_H
+#define AIG_ENGINE_H
+
+#include "Engine.h"
+#include "Aig.h"
+#include <cstdint>
+#include <vector>
+
+// Simulates the netlist's And-Inverter Graph: one uniform, branch-free node
+// loop over 8-byte nodes, with duplicated logic merged by structural
+// hashing. The graph is rebuilt after every structural edit. Gates in a
+// combinational loop see the loop's values from the previous step.
+class AigEngine : public Engine {
+public:
+    const char* GetName() const override { return "AIG"; }
+    void Step(Netlist& netlist) override;
+
+    const AigNetlist& GetAigNetlist() const { return lowered; }
+
+private:
+    AigNetlist lowered;
+    std::vector<uint64_t> words;
+    uint64_t loweredVersion = UINT64_MAX;
+};
+
+#endif // AIG_ENGINE_H
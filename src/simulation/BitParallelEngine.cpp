@@ -0,0 +1,177 @@
+#include "BitParallelEngine.h"
+#include "Subcircuit.h"
+#include <algorithm>
+
+void BitParallelEngine::Step(Netlist& netlist) {
+    // Values reset or restored outside the engine replace what the lanes hold
+    Prepare(netlist);
+    for (GateId gate : netlist.GetDirtyGates()) {
+        if (netlist.IsValidGate(gate)) {
+            NetId output = netlist.GetOutput(gate);
+            netLanes[output] = netlist.GetNetValue(output) ? ~0ull : 0;
+        }
+    }
+    Evaluate(netlist);
+
+    uint8_t* values = netlist.GetValueData();
+    for (size_t net = Netlist::CONST1 + 1; net < netLanes.size(); ++net) {
+        values[net] = netLanes[net] & 1;
+    }
+    netlist.ClearDirtyGates();
+}
+
+void BitParallelEngine::Evaluate(const Netlist& netlist) {
+    Prepare(netlist);
+
+    uint64_t* lanes = netLanes.data();
+    for (const Batch& batch : batches) {
+        switch (batch.kind) {
+            case GateKind::AND:
+                kernels->evalAnd(lanes, &batchIn0[batch.begin], &batchIn1[batch.begin], &batchOut[batch.begin], batch.count);
+                break;
+            case GateKind::OR:
+                kernels->evalOr(lanes, &batchIn0[batch.begin], &batchIn1[batch.begin], &batchOut[batch.begin], batch.count);
+                break;
+            case GateKind::NOT:
+                kernels->evalNot(lanes, &batchIn0[batch.begin], &batchOut[batch.begin], batch.count);
+                break;
+            case GateKind::XOR:
+                kernels->evalXor(lanes, &batchIn0[batch.begin], &batchIn1[batch.begin], &batchOut[batch.begin], batch.count);
+                break;
+            default:
+                EvaluateGeneric(netlist, &genericGates[batch.begin], batch.count);
+                break;
+        }
+    }
+}
+
+void BitParallelEngine::EvaluateGeneric(const Netlist& netlist, const CompiledGate* gates, size_t count) {
+    uint64_t* lanes = netLanes.data();
+    const NetId* faninData = compiled.GetFanin().data();
+    for (size_t g = 0; g < count; ++g) {
+        const CompiledGate& op = gates[g];
+        const NetId* in = faninData + op.faninBegin;
+        uint64_t value = 0;
+        switch (op.kind) {
+            case GateKind::INPUT:
+                value = hasInputLanes[op.gate] ? inputLanes[op.gate]
+                                               : (netlist.GetInputValue(op.gate) ? ~0ull : 0);
+                break;
+            case GateKind::AND:
+                value = op.faninCount != 0 ? ~0ull : 0;
+                for (uint32_t i = 0; i < op.faninCount; ++i) value &= lanes[in[i]];
+                break;
+            case GateKind::OR:
+                for (uint32_t i = 0; i < op.faninCount; ++i) value |= lanes[in[i]];
+                break;
+            case GateKind::NOT:
+                value = ~lanes[in[0]];
+                break;
+            case GateKind::XOR:
+                for (uint32_t i = 0; i < op.faninCount; ++i) value ^= lanes[in[i]];
+                break;
+            case GateKind::SUBCIRCUIT:
+                pinLanes.resize(op.faninCount);
+                for (uint32_t i = 0; i < op.faninCount; ++i) pinLanes[i] = lanes[in[i]];
+                value = netlist.GetSubcircuitDefinition(netlist.GetSubcircuitOf(op.gate))
+                            .EvaluatePort(pinLanes.data(), netlist.GetSubcircuitPort(op.gate));
+                break;
+            case GateKind::NONE:
+                break;
+        }
+        lanes[op.output] = value;
+    }
+}
+
+void BitParallelEngine::SetInputLanes(GateId gate, uint64_t lanes) {
+    if (gate >= inputLanes.size()) {
+        inputLanes.resize(gate + 1, 0);
+        hasInputLanes.resize(gate + 1, 0);
+    }
+    inputLanes[gate] = lanes;
+    hasInputLanes[gate] = 1;
+}
+
+void BitParallelEngine::ClearInputLanes() {
+    std::fill(hasInputLanes.begin(), hasInputLanes.end(), 0);
+}
+
+void BitParallelEngine::Prepare(const Netlist& netlist) {
+    if (!compiled.IsCurrent(netlist)) {
+        compiled.Compile(netlist);
+        BuildBatches();
+    }
+    if (netLanes.size() != netlist.GetNetCount()) {
+        netLanes.resize(netlist.GetNetCount(), 0);
+    }
+    netLanes[Netlist::CONST0] = 0;
+    netLanes[Netlist::CONST1] = ~0ull;
+    if (inputLanes.size() < netlist.GetGateCount()) {
+        inputLanes.resize(netlist.GetGateCount(), 0);
+        hasInputLanes.resize(netlist.GetGateCount(), 0);
+    }
+}
+
+void BitParallelEngine::BuildBatches() {
+    batches.clear();
+    batchIn0.clear();
+    batchIn1.clear();
+    batchOut.clear();
+    genericGates.clear();
+
+    const std::vector<CompiledGate>& gates = compiled.GetGates();
+    const std::vector<uint32_t>& levelOffsets = compiled.GetLevelOffsets();
+
+    // Gates on one level never read each other, so each level can be split
+    // by kind and the runs evaluated in any order
+    std::vector<const CompiledGate*> andRun, orRun, notRun, xorRun;
+    for (size_t level = 0; level < compiled.GetLevelCount(); ++level) {
+        andRun.clear();
+        orRun.clear();
+        notRun.clear();
+        xorRun.clear();
+        uint32_t genericBegin = static_cast<uint32_t>(genericGates.size());
+        for (uint32_t i = levelOffsets[level]; i < levelOffsets[level + 1]; ++i) {
+            const CompiledGate& op = gates[i];
+            if (op.kind == GateKind::AND && op.faninCount == 2) {
+                andRun.push_back(&op);
+            } else if (op.kind == GateKind::OR && op.faninCount == 2) {
+                orRun.push_back(&op);
+            } else if (op.kind == GateKind::NOT) {
+                notRun.push_back(&op);
+            } else if (op.kind == GateKind::XOR && op.faninCount == 2) {
+                xorRun.push_back(&op);
+            } else {
+                genericGates.push_back(op);
+            }
+        }
+        if (genericGates.size() > genericBegin) {
+            batches.push_back({ GateKind::NONE, genericBegin, static_cast<uint32_t>(genericGates.size() - genericBegin) });
+        }
+        EmitKernelRun(GateKind::AND, andRun);
+        EmitKernelRun(GateKind::OR, orRun);
+        EmitKernelRun(GateKind::NOT, notRun);
+        EmitKernelRun(GateKind::XOR, xorRun);
+    }
+
+    // Gates in combinational loops depend on each other and keep their order
+    uint32_t cyclicBegin = levelOffsets.empty() ? 0 : levelOffsets.back();
+    if (cyclicBegin < gates.size()) {
+        uint32_t genericBegin = static_cast<uint32_t>(genericGates.size());
+        genericGates.insert(genericGates.end(), gates.begin() + cyclicBegin, gates.end());
+        batches.push_back({ GateKind::NONE, genericBegin, static_cast<uint32_t>(gates.size() - cyclicBegin) });
+    }
+}
+
+void BitParallelEngine::EmitKernelRun(GateKind kind, const std::vector<const CompiledGate*>& run) {
+    if (run.empty()) return;
+
+    const NetId* faninData = compiled.GetFanin().data();
+    uint32_t begin = static_cast<uint32_t>(batchOut.size());
+    for (const CompiledGate* op : run) {
+        batchIn0.push_back(faninData[op->faninBegin]);
+        batchIn1.push_back(op->faninCount > 1 ? faninData[op->faninBegin + 1] : Netlist::CONST0);
+        batchOut.push_back(op->output);
+    }
+    batches.push_back({ kind, begin, static_cast<uint32_t>(run.size()) });
+}
@@ -0,0 +1,70 @@
+#ifndef BIT_PARALLEL_ENGINE_H
+#define BIT_PARALLEL_ENGINE_H
+
+#include "Engine.h"
+#include "CompiledNetlist.h"
+#include "GateKernels.h"
+#include <cstdint>
+#include <vector>
+
+// Simulates 64 independent input vectors at once. Every net holds a 64-bit
+// word with one lane per vector, and every gate evaluates all lanes with one
+// bitwise operation over the compiled, levelized netlist.
+//
+// Within each level, two-input AND/OR and NOT gates are grouped into runs
+// of the same kind and evaluated by the SIMD kernels picked for this CPU;
+// everything else goes through a scalar switch.
+//
+// As an Engine it drives lane 0 from the netlist's input values and writes
+// lane 0 back, so it can stand in for the scalar engines. For vector
+// sweeps, set per-input stimulus words and call Evaluate() directly.
+class BitParallelEngine : public Engine {
+public:
+    static const int LANES = 64;
+
+    const char* GetName() const override { return "Bit-parallel"; }
+    void Step(Netlist& netlist) override;
+
+    // Settles all lanes without touching the netlist's scalar values
+    void Evaluate(const Netlist& netlist);
+
+    // Stimulus for an INPUT gate; without one the gate's scalar value is
+    // broadcast to every lane
+    void SetInputLanes(GateId gate, uint64_t lanes);
+    void ClearInputLanes();
+
+    uint64_t GetNetLanes(NetId net) const { return netLanes[net]; }
+    const std::vector<uint64_t>& GetLaneData() const { return netLanes; }
+
+    void SetKernels(const GateKernels& newKernels) { kernels = &newKernels; }
+    const char* GetKernelName() const { return kernels->name; }
+
+private:
+    // A run of independent gates. Kernel runs index batchIn0/batchIn1/batchOut;
+    // NONE runs index genericGates and are evaluated in order.
+    struct Batch {
+        GateKind kind;
+        uint32_t begin;
+        uint32_t count;
+    };
+
+    void Prepare(const Netlist& netlist);
+    void BuildBatches();
+    void EmitKernelRun(GateKind kind, const std::vector<const CompiledGate*>& run);
+    void EvaluateGeneric(const Netlist& netlist, const CompiledGate* gates, size_t count);
+
+    CompiledNetlist compiled;
+    const GateKernels* kernels = &GetGateKernels();
+    std::vector<Batch> batches;
+    std::vector<NetId> batchIn0;
+    std::vector<NetId> batchIn1;
+    std::vector<NetId> batchOut;
+    std::vector<CompiledGate> genericGates;
+    std::vector<uint64_t> netLanes;
+    std::vector<uint64_t> inputLanes;
+    std::vector<uint8_t> hasInputLanes;
+    // Pin words of the subcircuit port being evaluated
+    std::vector<uint64_t> pinLanes;
+};
+
+#endif // BIT_PARALLEL_ENGINE_H
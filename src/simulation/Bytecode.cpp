@@ -0,0 +1,122 @@
+#include "Bytecode.h"
+#include "GateEvaluation.h"
+#include "Subcircuit.h"
+
+// GCC and Clang jump straight from one handler to the next through a label
+// table; other compilers fall back to a switch in a loop
+#if defined(__GNUC__) && !defined(LCS_NO_THREADED_DISPATCH)
+#define LCS_THREADED_DISPATCH 1
+#else
+#define LCS_THREADED_DISPATCH 0
+#endif
+
+void BytecodeProgram::Compile(const CompiledNetlist& compiled) {
+    code.clear();
+    instructionCount = 0;
+    const std::vector<NetId>& fanin = compiled.GetFanin();
+    for (const CompiledGate& op : compiled.GetGates()) {
+        const NetId* in = fanin.data() + op.faninBegin;
+        switch (op.kind) {
+            case GateKind::INPUT:
+                Emit(Opcode::INPUT);
+                code.push_back(op.output);
+                code.push_back(op.gate);
+                break;
+            case GateKind::AND:
+            case GateKind::OR:
+            case GateKind::XOR:
+                if (op.faninCount == 0) {
+                    Emit(Opcode::ZERO);
+                    code.push_back(op.output);
+                } else if (op.faninCount == 2) {
+                    Emit(op.kind == GateKind::AND ? Opcode::AND2 : op.kind == GateKind::OR ? Opcode::OR2 : Opcode::XOR2);
+                    code.push_back(op.output);
+                    code.insert(code.end(), in, in + 2);
+                } else {
+                    Emit(op.kind == GateKind::AND ? Opcode::ANDN : op.kind == GateKind::OR ? Opcode::ORN : Opcode::XORN);
+                    code.push_back(op.output);
+                    code.push_back(op.faninCount);
+                    code.insert(code.end(), in, in + op.faninCount);
+                }
+                break;
+            case GateKind::NOT:
+                Emit(Opcode::NOT);
+                code.push_back(op.output);
+                code.push_back(in[0]);
+                break;
+            case GateKind::SUBCIRCUIT:
+                Emit(Opcode::SUBCIRCUIT);
+                code.push_back(op.output);
+                code.push_back(op.gate);
+                break;
+            case GateKind::NONE:
+                continue;
+        }
+        ++instructionCount;
+    }
+    Emit(Opcode::HALT);
+}
+
+void BytecodeProgram::Run(const Netlist& netlist, uint8_t* values) const {
+    const uint32_t* pc = code.data();
+
+#if LCS_THREADED_DISPATCH
+    // Indexed by Opcode
+    static const void* const handlers[] = {
+        &&op_HALT, &&op_INPUT, &&op_ZERO, &&op_AND2, &&op_OR2, &&op_NOT, &&op_ANDN, &&op_ORN, &&op_XOR2, &&op_XORN,
+        &&op_SUBCIRCUIT
+    };
+#define LCS_OP(name) op_##name
+#define LCS_NEXT(size) { pc += (size); goto *handlers[*pc]; }
+    LCS_NEXT(0);
+#else
+#define LCS_OP(name) case Opcode::name
+#define LCS_NEXT(size) { pc += (size); continue; }
+    for (;;) switch (static_cast<Opcode>(*pc)) {
+#endif
+
+    LCS_OP(HALT):
+        return;
+    LCS_OP(INPUT):
+        values[pc[1]] = netlist.GetInputValue(pc[2]);
+        LCS_NEXT(3);
+    LCS_OP(ZERO):
+        values[pc[1]] = 0;
+        LCS_NEXT(2);
+    LCS_OP(AND2):
+        values[pc[1]] = values[pc[2]] & values[pc[3]];
+        LCS_NEXT(4);
+    LCS_OP(OR2):
+        values[pc[1]] = values[pc[2]] | values[pc[3]];
+        LCS_NEXT(4);
+    LCS_OP(NOT):
+        values[pc[1]] = values[pc[2]] ^ 1;
+        LCS_NEXT(3);
+    LCS_OP(ANDN): {
+        uint32_t count = pc[2];
+        values[pc[1]] = GateKernel<GateKind::AND>::Evaluate(values, pc + 3, count, 0);
+        LCS_NEXT(3 + count);
+    }
+    LCS_OP(ORN): {
+        uint32_t count = pc[2];
+        values[pc[1]] = GateKernel<GateKind::OR>::Evaluate(values, pc + 3, count, 0);
+        LCS_NEXT(3 + count);
+    }
+    LCS_OP(XOR2):
+        values[pc[1]] = values[pc[2]] ^ values[pc[3]];
+        LCS_NEXT(4);
+    LCS_OP(XORN): {
+        uint32_t count = pc[2];
+        values[pc[1]] = GateKernel<GateKind::XOR>::Evaluate(values, pc + 3, count, 0);
+        LCS_NEXT(3 + count);
+    }
+    LCS_OP(SUBCIRCUIT):
+        values[pc[1]] = EvaluateSubcircuitPort(netlist, pc[2], values);
+        LCS_NEXT(3);
+
+#if !LCS_THREADED_DISPATCH
+    }
+#endif
+#undef LCS_OP
+#undef LCS_NEXT
+}
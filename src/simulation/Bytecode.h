@@ -0,0 +1,41 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include "CompiledNetlist.h"
+#include <cstdint>
+#include <vector>
+
+// Instruction set of the bytecode engine. Every instruction is a run of
+// 32-bit words: the opcode, the net it writes, then its operands.
+enum class Opcode : uint32_t {
+    HALT,   // end of program
+    INPUT,  // out, gate        out = input value of gate
+    ZERO,   // out              AND/OR/XOR without inputs
+    AND2,   // out, a, b
+    OR2,    // out, a, b
+    NOT,    // out, a
+    ANDN,   // out, n, a0..an-1
+    ORN,    // out, n, a0..an-1
+    XOR2,   // out, a, b
+    XORN,   // out, n, a0..an-1
+    SUBCIRCUIT  // out, gate    out = port of a subcircuit instance
+};
+
+// A compiled netlist lowered to a flat instruction stream
+class BytecodeProgram {
+public:
+    void Compile(const CompiledNetlist& compiled);
+    // Executes the program once over one 0/1 byte per net
+    void Run(const Netlist& netlist, uint8_t* values) const;
+
+    const std::vector<uint32_t>& GetCode() const { return code; }
+    size_t GetInstructionCount() const { return instructionCount; }
+
+private:
+    void Emit(Opcode opcode) { code.push_back(static_cast<uint32_t>(opcode)); }
+
+    std::vector<uint32_t> code;
+    size_t instructionCount = 0;
+};
+
+#endif // BYTECODE_H
@@ -0,0 +1,11 @@
+#include "BytecodeEngine.h"
+
+void BytecodeEngine::Step(Netlist& netlist) {
+    if (!compiled.IsCurrent(netlist)) {
+        compiled.Compile(netlist);
+        program.Compile(compiled);
+    }
+
+    program.Run(netlist, netlist.GetValueData());
+    netlist.ClearDirtyGates();
+}
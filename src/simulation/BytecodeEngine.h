@@ -0,0 +1,25 @@
+#ifndef BYTECODE_ENGINE_H
+#define BYTECODE_ENGINE_H
+
+#include "Engine.h"
+#include "Bytecode.h"
+#include "CompiledNetlist.h"
+
+// Compiled-code simulation through a small bytecode interpreter. Each gate
+// becomes one instruction whose handler is specialized for its kind and
+// arity, so mixed gate types dispatch without a per-gate switch on kind
+// and input count. Recompiling after an edit is just a pass over the
+// levelized order.
+class BytecodeEngine : public Engine {
+public:
+    const char* GetName() const override { return "Bytecode"; }
+    void Step(Netlist& netlist) override;
+
+    const BytecodeProgram& GetProgram() const { return program; }
+
+private:
+    CompiledNetlist compiled;
+    BytecodeProgram program;
+};
+
+#endif // BYTECODE_ENGINE_H
@@ -0,0 +1,93 @@
+#include "CompiledNetlist.h"
+#include "Levelizer.h"
+#include "GateEvaluation.h"
+#include "Subcircuit.h"
+#include <algorithm>
+
+void CompiledNetlist::Compile(const Netlist& netlist) {
+    Levelization levels = Levelize(netlist);
+
+    // Gates on one level are independent, so grouping them by kind is free
+    for (size_t level = 0; level < levels.GetLevelCount(); ++level) {
+        std::stable_sort(levels.order.begin() + levels.levelOffsets[level],
+                         levels.order.begin() + levels.levelOffsets[level + 1],
+                         [&](GateId a, GateId b) { return netlist.GetKind(a) < netlist.GetKind(b); });
+    }
+
+    gates.clear();
+    fanin.clear();
+    gates.reserve(levels.order.size() + levels.cyclicGates.size());
+    for (GateId gate : levels.order) {
+        Emit(netlist, gate);
+    }
+    for (GateId gate : levels.cyclicGates) {
+        Emit(netlist, gate);
+    }
+
+    levelOffsets = std::move(levels.levelOffsets);
+    BuildRuns();
+    netCount = netlist.GetNetCount();
+    compiledVersion = netlist.GetTopologyVersion();
+}
+
+void CompiledNetlist::BuildRuns() {
+    runs.clear();
+    size_t level = 0;
+    for (uint32_t i = 0; i < gates.size(); ++i) {
+        // A run must end where a new level, or the loop gates, begin
+        bool boundary = false;
+        while (level < levelOffsets.size() && levelOffsets[level] <= i) {
+            boundary = boundary || levelOffsets[level] == i;
+            ++level;
+        }
+        if (boundary || runs.empty() || runs.back().kind != gates[i].kind) {
+            runs.push_back({ gates[i].kind, i, i + 1 });
+        } else {
+            runs.back().end = i + 1;
+        }
+    }
+}
+
+void CompiledNetlist::Emit(const Netlist& netlist, GateId gate) {
+    std::span<const NetId> inputs = netlist.GetFanin(gate);
+    gates.push_back({
+        netlist.GetKind(gate),
+        static_cast<uint32_t>(fanin.size()),
+        static_cast<uint32_t>(inputs.size()),
+        netlist.GetOutput(gate),
+        gate
+    });
+    fanin.insert(fanin.end(), inputs.begin(), inputs.end());
+}
+
+void EvaluateCompiledGates(const Netlist& netlist, uint8_t* values, const NetId* fanin,
+                           const CompiledGate* begin, const CompiledGate* end) {
+    const uint8_t* inputValues = netlist.GetInputValueData();
+    for (const CompiledGate* op = begin; op != end; ++op) {
+        const NetId* in = fanin + op->faninBegin;
+        uint8_t value = 0;
+        switch (op->kind) {
+            case GateKind::INPUT:
+                value = GateKernel<GateKind::INPUT>::Evaluate(values, in, op->faninCount, inputValues[op->gate]);
+                break;
+            case GateKind::AND:
+                value = GateKernel<GateKind::AND>::Evaluate(values, in, op->faninCount, 0);
+                break;
+            case GateKind::OR:
+                value = GateKernel<GateKind::OR>::Evaluate(values, in, op->faninCount, 0);
+                break;
+            case GateKind::NOT:
+                value = GateKernel<GateKind::NOT>::Evaluate(values, in, op->faninCount, 0);
+                break;
+            case GateKind::XOR:
+                value = GateKernel<GateKind::XOR>::Evaluate(values, in, op->faninCount, 0);
+                break;
+            case GateKind::SUBCIRCUIT:
+                value = EvaluateSubcircuitPort(netlist, op->gate, values);
+                break;
+            case GateKind::NONE:
+                break;
+        }
+        values[op->output] = value;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef COMPILED_NETLIST_H
+#define COMPILED_NETLIST_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <vector>
+
+// One gate of a compiled netlist. Its inputs are
+// fanin[faninBegin, faninBegin + faninCount).
+struct CompiledGate {
+    GateKind kind;
+    uint32_t faninBegin;
+    uint32_t faninCount;
+    NetId output;
+    GateId gate;
+};
+
+// Consecutive compiled gates of one kind: GetGates()[begin, end)
+struct GateRun {
+    GateKind kind;
+    uint32_t begin;
+    uint32_t end;
+};
+
+// A netlist flattened into dependency order for straight-line evaluation.
+// Levelized gates come first, level by level and grouped by kind within a
+// level; gates caught in combinational loops follow in slot order.
+class CompiledNetlist {
+public:
+    void Compile(const Netlist& netlist);
+    bool IsCurrent(const Netlist& netlist) const { return compiledVersion == netlist.GetTopologyVersion(); }
+
+    const std::vector<CompiledGate>& GetGates() const { return gates; }
+    const std::vector<NetId>& GetFanin() const { return fanin; }
+    // Runs never cross a level boundary or the start of the loop gates
+    const std::vector<GateRun>& GetRuns() const { return runs; }
+    size_t GetNetCount() const { return netCount; }
+
+    // Level l is GetGates()[levelOffsets[l], levelOffsets[l + 1]); loop gates
+    // start at levelOffsets.back()
+    const std::vector<uint32_t>& GetLevelOffsets() const { return levelOffsets; }
+    size_t GetLevelCount() const { return levelOffsets.empty() ? 0 : levelOffsets.size() - 1; }
+    size_t GetCyclicGateCount() const { return gates.size() - (levelOffsets.empty() ? 0 : levelOffsets.back()); }
+
+private:
+    void Emit(const Netlist& netlist, GateId gate);
+    void BuildRuns();
+
+    std::vector<CompiledGate> gates;
+    std::vector<GateRun> runs;
+    std::vector<NetId> fanin;
+    std::vector<uint32_t> levelOffsets;
+    size_t netCount = 0;
+    uint64_t compiledVersion = UINT64_MAX;
+};
+
+// Evaluates compiled gates [begin, end) in order, reading and writing one
+// 0/1 byte per net
+void EvaluateCompiledGates(const Netlist& netlist, uint8_t* values, const NetId* fanin,
+                           const CompiledGate* begin, const CompiledGate* end);
+
+#endif // COMPILED_NETLIST_H
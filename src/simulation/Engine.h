@@ -0,0 +1,21 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "Netlist.h"
+#include <vector>
+
+// Strategy for advancing a netlist by one simulation step
+class Engine {
+public:
+    virtual ~Engine() = default;
+
+    virtual const char* GetName() const = 0;
+    virtual void Step(Netlist& netlist) = 0;
+
+    // Nets the last step wrote a new value to, possibly more than once, for
+    // engines that only touch active nets. nullptr when a step rewrites
+    // every net, so callers must compare values to find the changes.
+    virtual const std::vector<NetId>* GetChangedNets() const { return nullptr; }
+};
+
+#endif // ENGINE_H
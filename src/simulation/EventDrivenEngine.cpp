@@ -0,0 +1,60 @@
+#include "EventDrivenEngine.h"
+
+void EventDrivenEngine::Step(Netlist& netlist) {
+    isScheduled.resize(netlist.GetGateCount(), 0);
+    changedNets.clear();
+
+    // The first step has no previous values to trust, so evaluate everything once
+    if (!primed) {
+        for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+            if (netlist.GetKind(gate) != GateKind::NONE) {
+                Schedule(gate);
+            }
+        }
+        primed = true;
+    }
+
+    for (GateId gate : netlist.GetDirtyGates()) {
+        if (netlist.IsValidGate(gate)) {
+            Schedule(gate);
+        }
+    }
+    netlist.ClearDirtyGates();
+
+    for (int i = 0; i < maxWaves && !scheduledGates.empty(); ++i) {
+        RunWave(netlist);
+    }
+}
+
+void EventDrivenEngine::Schedule(GateId gate) {
+    if (!isScheduled[gate]) {
+        isScheduled[gate] = 1;
+        scheduledGates.push_back(gate);
+    }
+}
+
+void EventDrivenEngine::RunWave(Netlist& netlist) {
+    // Evaluate the whole wave against the same input values before
+    // publishing any outputs, like a delta cycle in an HDL simulator
+    wave.swap(scheduledGates);
+    scheduledGates.clear();
+
+    results.resize(wave.size());
+    for (size_t i = 0; i < wave.size(); ++i) {
+        isScheduled[wave[i]] = 0;
+        results[i] = netlist.Evaluate(wave[i]);
+    }
+    evaluationCount += wave.size();
+
+    for (size_t i = 0; i < wave.size(); ++i) {
+        if (netlist.GetKind(wave[i]) == GateKind::NONE) continue;
+        NetId output = netlist.GetOutput(wave[i]);
+        if (netlist.GetNetValue(output) != static_cast<bool>(results[i])) {
+            netlist.SetNetValue(output, results[i]);
+            changedNets.push_back(output);
+            for (GateId reader : netlist.GetFanout(output)) {
+                Schedule(reader);
+            }
+        }
+    }
+}
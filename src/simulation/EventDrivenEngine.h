@@ -0,0 +1,42 @@
+#ifndef EVENT_DRIVEN_ENGINE_H
+#define EVENT_DRIVEN_ENGINE_H
+
+#include "Engine.h"
+#include "Netlist.h"
+#include <cstdint>
+#include <vector>
+
+// Re-evaluates only the fanout of nets whose value changed. Each step runs
+// waves of evaluation (delta cycles) until no net changes, so an input
+// change reaches the outputs within a single step. Oscillating circuits are
+// cut off after a bounded number of waves and resume on the next step.
+class EventDrivenEngine : public Engine {
+public:
+    static const int DEFAULT_MAX_WAVES = 1024;
+
+    const char* GetName() const override { return "Event-driven"; }
+    void Step(Netlist& netlist) override;
+    const std::vector<NetId>* GetChangedNets() const override { return &changedNets; }
+
+    void SetMaxWaves(int waves) { maxWaves = waves; }
+    int GetMaxWaves() const { return maxWaves; }
+
+    // False if the last step hit the wave limit with gates still scheduled
+    bool IsSettled() const { return scheduledGates.empty(); }
+    uint64_t GetEvaluationCount() const { return evaluationCount; }
+
+private:
+    void Schedule(GateId gate);
+    void RunWave(Netlist& netlist);
+
+    std::vector<GateId> scheduledGates;
+    std::vector<GateId> wave;
+    std::vector<uint8_t> results;
+    std::vector<uint8_t> isScheduled;
+    std::vector<NetId> changedNets;
+    bool primed = false;
+    int maxWaves = DEFAULT_MAX_WAVES;
+    uint64_t evaluationCount = 0;
+};
+
+#endif // EVENT_DRIVEN_ENGINE_H
@@ -0,0 +1,248 @@
+#include "FaultSimulator.h"
+#include "StronglyConnected.h"
+#include "Subcircuit.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <queue>
+
+namespace {
+
+// Fault batches per thread, so stealing can even out dropped faults
+constexpr size_t TASKS_PER_THREAD = 16;
+
+// Evaluates a gate over 64 patterns, reading nets through `word`
+template<typename WordFn>
+uint64_t EvaluateWord(const Netlist& netlist, GateId gate, WordFn&& word) {
+    std::span<const NetId> fanin = netlist.GetFanin(gate);
+    switch (netlist.GetKind(gate)) {
+        case GateKind::AND: {
+            if (fanin.empty()) return 0;
+            uint64_t value = ~uint64_t(0);
+            for (uint32_t pin = 0; pin < fanin.size(); ++pin) value &= word(pin, fanin[pin]);
+            return value;
+        }
+        case GateKind::OR: {
+            uint64_t value = 0;
+            for (uint32_t pin = 0; pin < fanin.size(); ++pin) value |= word(pin, fanin[pin]);
+            return value;
+        }
+        case GateKind::NOT:
+            return ~word(0, fanin[0]);
+        case GateKind::XOR: {
+            uint64_t value = 0;
+            for (uint32_t pin = 0; pin < fanin.size(); ++pin) value ^= word(pin, fanin[pin]);
+            return value;
+        }
+        case GateKind::SUBCIRCUIT: {
+            thread_local std::vector<uint64_t> pins;
+            pins.resize(fanin.size());
+            for (uint32_t pin = 0; pin < fanin.size(); ++pin) pins[pin] = word(pin, fanin[pin]);
+            return netlist.GetSubcircuitDefinition(netlist.GetSubcircuitOf(gate))
+                .EvaluatePort(pins.data(), netlist.GetSubcircuitPort(gate));
+        }
+        case GateKind::INPUT:
+        case GateKind::NONE:
+            break;
+    }
+    return 0;
+}
+
+// Per-task overlay of faulty net values on top of the good ones; an entry
+// only counts when its stamp matches the fault and word being propagated
+struct FaultScratch {
+    std::vector<uint64_t> faultyWords;
+    std::vector<uint32_t> netStamps;
+    std::vector<uint32_t> queuedStamps;
+    uint32_t stamp = 0;
+    std::priority_queue<std::pair<uint32_t, GateId>, std::vector<std::pair<uint32_t, GateId>>,
+                        std::greater<>> queue;
+};
+
+} // namespace
+
+std::vector<Fault> EnumerateStuckAtFaults(const Netlist& netlist) {
+    std::vector<Fault> faults;
+    for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+        if (!netlist.IsValidGate(gate)) continue;
+        for (uint8_t value = 0; value < 2; ++value) {
+            faults.push_back({ gate, FAULT_OUTPUT, value });
+            for (int32_t pin = 0; pin < static_cast<int32_t>(netlist.GetFanin(gate).size()); ++pin) {
+                faults.push_back({ gate, pin, value });
+            }
+        }
+    }
+    return faults;
+}
+
+bool SimulateFaults(const Netlist& netlist, const std::vector<GateId>& inputs,
+                    const std::vector<std::vector<uint8_t>>& patterns, FaultReport& report, std::string& error) {
+    report = FaultReport();
+    report.patternCount = patterns.size();
+
+    // Topological positions; faulty values are propagated in this order
+    SccDecomposition components = FindStronglyConnectedComponents(netlist);
+    std::vector<GateId> order;
+    std::vector<uint32_t> position(netlist.GetGateCount(), 0);
+    for (size_t component = 0; component < components.GetComponentCount(); ++component) {
+        if (components.componentCyclic[component]) {
+            error = "the circuit contains a combinational loop";
+            return false;
+        }
+        GateId gate = components.gates[components.componentOffsets[component]];
+        position[gate] = static_cast<uint32_t>(order.size());
+        order.push_back(gate);
+    }
+
+    std::vector<uint8_t> isObserved(netlist.GetNetCount(), 0);
+    for (GateId gate : order) {
+        GateKind kind = netlist.GetKind(gate);
+        if (kind == GateKind::INPUT && inputs.empty()) report.inputs.push_back(gate);
+        bool observed = netlist.GetProbeCount() > 0
+            ? netlist.IsProbed(gate)
+            : kind != GateKind::INPUT && netlist.GetFanout(netlist.GetOutput(gate)).empty();
+        if (observed) {
+            report.observed.push_back(gate);
+            isObserved[netlist.GetOutput(gate)] = 1;
+        }
+    }
+    if (inputs.empty()) {
+        std::sort(report.inputs.begin(), report.inputs.end());
+    } else {
+        for (GateId gate : inputs) {
+            if (!netlist.IsValidGate(gate) || netlist.GetKind(gate) != GateKind::INPUT) {
+                error = "gate " + std::to_string(gate) + " is not an input";
+                return false;
+            }
+        }
+        report.inputs = inputs;
+    }
+    std::sort(report.observed.begin(), report.observed.end());
+
+    report.faults = EnumerateStuckAtFaults(netlist);
+    report.detectingPatterns.assign(report.faults.size(), UNDETECTED);
+
+    // Faults not yet detected, compacted after every block
+    std::vector<uint32_t> remaining(report.faults.size());
+    for (size_t index = 0; index < remaining.size(); ++index) remaining[index] = static_cast<uint32_t>(index);
+
+    ThreadPool& pool = ThreadPool::GetShared();
+    const size_t netCount = netlist.GetNetCount();
+    const size_t blockCount = (patterns.size() + 63) / 64;
+    std::vector<uint64_t> good(netCount, 0);
+    // One scratch per task slot, reused by every block
+    std::vector<FaultScratch> scratches(pool.GetThreadCount() * TASKS_PER_THREAD);
+
+    for (size_t block = 0; block < blockCount && !remaining.empty(); ++block) {
+        // Good values of every net for this block's 64 patterns
+        std::fill(good.begin(), good.end(), 0);
+        good[Netlist::CONST1] = ~uint64_t(0);
+        size_t lanes = std::min<size_t>(64, patterns.size() - block * 64);
+        uint64_t laneMask = lanes < 64 ? (uint64_t(1) << lanes) - 1 : ~uint64_t(0);
+        for (size_t input = 0; input < report.inputs.size(); ++input) {
+            uint64_t word = 0;
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                const std::vector<uint8_t>& pattern = patterns[block * 64 + lane];
+                if (input < pattern.size() && pattern[input]) word |= uint64_t(1) << lane;
+            }
+            good[netlist.GetOutput(report.inputs[input])] = word;
+        }
+        for (GateId gate : order) {
+            if (netlist.GetKind(gate) == GateKind::INPUT) continue;
+            good[netlist.GetOutput(gate)] = EvaluateWord(netlist, gate, [&](uint32_t, NetId net) { return good[net]; });
+        }
+
+        size_t taskCount = std::min(remaining.size(), scratches.size());
+        pool.ParallelFor(taskCount, [&](size_t task) {
+            FaultScratch& scratch = scratches[task];
+            if (scratch.faultyWords.size() != netCount) {
+                scratch.faultyWords.assign(netCount, 0);
+                scratch.netStamps.assign(netCount, 0);
+                scratch.queuedStamps.assign(netlist.GetGateCount(), 0);
+            }
+
+            size_t first = remaining.size() * task / taskCount;
+            size_t last = remaining.size() * (task + 1) / taskCount;
+            for (size_t slot = first; slot < last; ++slot) {
+                const uint32_t index = remaining[slot];
+                const Fault& fault = report.faults[index];
+                uint64_t stuckWord = fault.stuckAt ? ~uint64_t(0) : 0;
+
+                uint32_t stamp = ++scratch.stamp;
+                auto word = [&](NetId net) {
+                    return scratch.netStamps[net] == stamp ? scratch.faultyWords[net] : good[net];
+                };
+
+                // Records a changed net and schedules its readers. Every
+                // observed difference in the word counts, so the first
+                // detecting pattern is exact.
+                uint64_t detected = 0;
+                auto setFaulty = [&](GateId gate, uint64_t value) {
+                    NetId net = netlist.GetOutput(gate);
+                    uint64_t difference = (value ^ good[net]) & laneMask;
+                    if (difference == 0) return;
+                    if (isObserved[net]) detected |= difference;
+                    scratch.faultyWords[net] = value;
+                    scratch.netStamps[net] = stamp;
+                    for (GateId reader : netlist.GetFanout(net)) {
+                        if (scratch.queuedStamps[reader] != stamp) {
+                            scratch.queuedStamps[reader] = stamp;
+                            scratch.queue.push({ position[reader], reader });
+                        }
+                    }
+                };
+
+                if (fault.pin == FAULT_OUTPUT) {
+                    setFaulty(fault.gate, stuckWord);
+                } else {
+                    setFaulty(fault.gate, EvaluateWord(netlist, fault.gate, [&](uint32_t pin, NetId net) {
+                        return pin == static_cast<uint32_t>(fault.pin) ? stuckWord : good[net];
+                    }));
+                }
+                while (!scratch.queue.empty()) {
+                    GateId gate = scratch.queue.top().second;
+                    scratch.queue.pop();
+                    // The faulted gate's own output stays stuck
+                    if (fault.pin == FAULT_OUTPUT && gate == fault.gate) continue;
+                    uint64_t value = EvaluateWord(netlist, gate, [&](uint32_t pin, NetId net) {
+                        if (gate == fault.gate && pin == static_cast<uint32_t>(fault.pin)) return stuckWord;
+                        return word(net);
+                    });
+                    setFaulty(gate, value);
+                }
+                if (detected) {
+                    report.detectingPatterns[index] = static_cast<uint32_t>(block * 64 + std::countr_zero(detected));
+                }
+            }
+        });
+
+        // Fault dropping: detected faults skip the remaining blocks
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                       [&](uint32_t index) { return report.detectingPatterns[index] != UNDETECTED; }),
+                        remaining.end());
+    }
+
+    report.detectedCount = static_cast<size_t>(std::count_if(report.detectingPatterns.begin(), report.detectingPatterns.end(),
+                                                             [](uint32_t pattern) { return pattern != UNDETECTED; }));
+    return true;
+}
+
+void WriteFaultReport(const FaultReport& report, std::ostream& out) {
+    out << "Patterns: " << report.patternCount << "\n";
+    out << "Inputs: " << report.inputs.size() << ", observed outputs: " << report.observed.size() << "\n";
+    out << "Faults: " << report.faults.size() << ", detected: " << report.detectedCount
+        << ", coverage: " << report.GetCoverage() * 100.0 << "%\n";
+    out << "Undetected faults:\n";
+    for (size_t index = 0; index < report.faults.size(); ++index) {
+        if (report.detectingPatterns[index] != UNDETECTED) continue;
+        const Fault& fault = report.faults[index];
+        out << "  gate " << fault.gate << " ";
+        if (fault.pin == FAULT_OUTPUT) {
+            out << "output";
+        } else {
+            out << "input " << fault.pin;
+        }
+        out << " stuck-at-" << int(fault.stuckAt) << "\n";
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef FAULT_SIMULATOR_H
+#define FAULT_SIMULATOR_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+constexpr int32_t FAULT_OUTPUT = -1;
+constexpr uint32_t UNDETECTED = UINT32_MAX;
+
+// A single pin held at a constant value
+struct Fault {
+    GateId gate;
+    int32_t pin;      // input pin, or FAULT_OUTPUT for the gate's output
+    uint8_t stuckAt;
+};
+
+struct FaultReport {
+    std::vector<GateId> inputs;    // INPUT gates in the order the patterns list them
+    std::vector<GateId> observed;  // gates whose outputs are compared
+    std::vector<Fault> faults;
+    std::vector<uint32_t> detectingPatterns;  // first pattern detecting each fault, or UNDETECTED
+    size_t patternCount = 0;
+    size_t detectedCount = 0;
+
+    double GetCoverage() const { return faults.empty() ? 1.0 : double(detectedCount) / faults.size(); }
+};
+
+// Stuck-at-0 and stuck-at-1 on the output and every input pin of every gate
+std::vector<Fault> EnumerateStuckAtFaults(const Netlist& netlist);
+
+// Parallel-pattern single-fault propagation, one block of 64 patterns at a
+// time: good values are simulated for the block, then each fault still
+// undetected is injected and pushed through its fanout cone only as far as
+// it changes values. A fault is dropped from later blocks once an observed
+// output differs. Faults are spread across the shared thread pool, and
+// memory stays at one block of good values however many patterns there are.
+//
+// patterns[p][i] is the value of inputs[i] in pattern p; with no inputs
+// given, every INPUT gate in slot order. Probed gates are observed, or every
+// gate nothing reads when there are no probes. Fails on combinational loops.
+bool SimulateFaults(const Netlist& netlist, const std::vector<GateId>& inputs,
+                    const std::vector<std::vector<uint8_t>>& patterns, FaultReport& report, std::string& error);
+
+// Coverage summary followed by every undetected fault
+void WriteFaultReport(const FaultReport& report, std::ostream& out);
+
+#endif // FAULT_SIMULATOR_H
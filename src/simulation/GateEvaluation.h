@@ -0,0 +1,108 @@
+#ifndef GATE_EVALUATION_H
+#define GATE_EVALUATION_H
+
+#include "CompiledNetlist.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+// Compile-time gate semantics. Each kind specializes GateKernel with an
+// Evaluate that computes the gate's 0/1 output from its input nets (or, for
+// INPUT gates, from the externally driven value). Adding a primitive means
+// adding its GateKind, bumping GATE_KIND_COUNT and specializing GateKernel;
+// the run table below picks it up without any per-gate indirection.
+template <GateKind Kind>
+struct GateKernel;
+
+// Values of up to 64 input pins packed into one word, pin i at bit i, so
+// wide gates reduce a whole word at once instead of branching per pin
+inline uint64_t PackInputBits(const uint8_t* values, const NetId* in, uint32_t count) {
+    uint64_t bits = 0;
+    for (uint32_t i = 0; i < count; ++i) bits |= uint64_t(values[in[i]]) << i;
+    return bits;
+}
+
+inline uint64_t LowBitMask(uint32_t count) {
+    return count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+}
+
+template <>
+struct GateKernel<GateKind::NONE> {
+    static uint8_t Evaluate(const uint8_t*, const NetId*, uint32_t, uint8_t) { return 0; }
+};
+
+template <>
+struct GateKernel<GateKind::INPUT> {
+    static uint8_t Evaluate(const uint8_t*, const NetId*, uint32_t, uint8_t inputValue) { return inputValue; }
+};
+
+template <>
+struct GateKernel<GateKind::AND> {
+    static uint8_t Evaluate(const uint8_t* values, const NetId* in, uint32_t count, uint8_t) {
+        for (uint32_t first = 0; first < count; first += 64) {
+            uint32_t chunk = std::min<uint32_t>(count - first, 64);
+            if (PackInputBits(values, in + first, chunk) != LowBitMask(chunk)) return 0;
+        }
+        return count != 0;
+    }
+};
+
+template <>
+struct GateKernel<GateKind::OR> {
+    static uint8_t Evaluate(const uint8_t* values, const NetId* in, uint32_t count, uint8_t) {
+        for (uint32_t first = 0; first < count; first += 64) {
+            if (PackInputBits(values, in + first, std::min<uint32_t>(count - first, 64)) != 0) return 1;
+        }
+        return 0;
+    }
+};
+
+template <>
+struct GateKernel<GateKind::NOT> {
+    static uint8_t Evaluate(const uint8_t* values, const NetId* in, uint32_t, uint8_t) { return values[in[0]] ^ 1; }
+};
+
+template <>
+struct GateKernel<GateKind::XOR> {
+    static uint8_t Evaluate(const uint8_t* values, const NetId* in, uint32_t count, uint8_t) {
+        int parity = 0;
+        for (uint32_t first = 0; first < count; first += 64) {
+            parity ^= std::popcount(PackInputBits(values, in + first, std::min<uint32_t>(count - first, 64)));
+        }
+        return static_cast<uint8_t>(parity & 1);
+    }
+};
+
+// A subcircuit port depends on the instance's shared definition, which the
+// kernel signature cannot reach; callers route SUBCIRCUIT gates to
+// EvaluateSubcircuitPort or EvaluateSubcircuitGates instead
+template <>
+struct GateKernel<GateKind::SUBCIRCUIT> {
+    static uint8_t Evaluate(const uint8_t*, const NetId*, uint32_t, uint8_t) { return 0; }
+};
+
+// Evaluates a run of compiled gates that all share one kind
+using GateRunFunction = void (*)(const uint8_t* inputValues, uint8_t* values, const NetId* fanin,
+                                 const CompiledGate* begin, const CompiledGate* end);
+
+template <GateKind Kind>
+void EvaluateGateRun(const uint8_t* inputValues, uint8_t* values, const NetId* fanin,
+                     const CompiledGate* begin, const CompiledGate* end) {
+    for (const CompiledGate* op = begin; op != end; ++op) {
+        uint8_t inputValue = Kind == GateKind::INPUT ? inputValues[op->gate] : 0;
+        values[op->output] = GateKernel<Kind>::Evaluate(values, fanin + op->faninBegin, op->faninCount, inputValue);
+    }
+}
+
+template <size_t... Kinds>
+constexpr std::array<GateRunFunction, sizeof...(Kinds)> MakeGateRunTable(std::index_sequence<Kinds...>) {
+    return { &EvaluateGateRun<static_cast<GateKind>(Kinds)>... };
+}
+
+// One monomorphic loop per gate kind, indexed by GateKind
+inline constexpr std::array<GateRunFunction, GATE_KIND_COUNT> GATE_RUN_TABLE =
+    MakeGateRunTable(std::make_index_sequence<GATE_KIND_COUNT>());
+
+#endif // GATE_EVALUATION_H
@@ -0,0 +1,168 @@
+#include "GateKernels.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LCS_X86_KERNELS 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define LCS_TARGET(isa)
+#else
+#define LCS_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace {
+
+void ScalarAnd(uint64_t* lanes, const NetId* in0, const NetId* in1, const NetId* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) lanes[out[i]] = lanes[in0[i]] & lanes[in1[i]];
+}
+
+void ScalarOr(uint64_t* lanes, const NetId* in0, const NetId* in1, const NetId* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) lanes[out[i]] = lanes[in0[i]] | lanes[in1[i]];
+}
+
+void ScalarXor(uint64_t* lanes, const NetId* in0, const NetId* in1, const NetId* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) lanes[out[i]] = lanes[in0[i]] ^ lanes[in1[i]];
+}
+
+void ScalarNot(uint64_t* lanes, const NetId* in, const NetId* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) lanes[out[i]] = ~lanes[in[i]];
+}
+
+const GateKernels scalarKernels = { "scalar", ScalarAnd, ScalarOr, ScalarNot, ScalarXor };
+
+#ifdef LCS_X86_KERNELS
+
+// AVX2 has gathers but no scatter, so results are stored one word at a time
+#define LCS_AVX2_BINARY_KERNEL(name, op, scalarOp)                                                           \
+    LCS_TARGET("avx2") void name(uint64_t* lanes, const NetId* in0, const NetId* in1, const NetId* out, size_t count) { \
+        const long long* base = reinterpret_cast<const long long*>(lanes);                                  \
+        alignas(32) uint64_t result[4];                                                                      \
+        size_t i = 0;                                                                                        \
+        for (; i + 4 <= count; i += 4) {                                                                     \
+            __m256i a = _mm256_i32gather_epi64(base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + i)), 8); \
+            __m256i b = _mm256_i32gather_epi64(base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + i)), 8); \
+            _mm256_store_si256(reinterpret_cast<__m256i*>(result), op(a, b));                                \
+            lanes[out[i]] = result[0];                                                                       \
+            lanes[out[i + 1]] = result[1];                                                                   \
+            lanes[out[i + 2]] = result[2];                                                                   \
+            lanes[out[i + 3]] = result[3];                                                                   \
+        }                                                                                                    \
+        for (; i < count; ++i) lanes[out[i]] = lanes[in0[i]] scalarOp lanes[in1[i]];                        \
+    }
+
+LCS_AVX2_BINARY_KERNEL(Avx2And, _mm256_and_si256, &)
+LCS_AVX2_BINARY_KERNEL(Avx2Or, _mm256_or_si256, |)
+LCS_AVX2_BINARY_KERNEL(Avx2Xor, _mm256_xor_si256, ^)
+
+LCS_TARGET("avx2") void Avx2Not(uint64_t* lanes, const NetId* in, const NetId* out, size_t count) {
+    const long long* base = reinterpret_cast<const long long*>(lanes);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    alignas(32) uint64_t result[4];
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_i32gather_epi64(base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), 8);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result), _mm256_xor_si256(a, ones));
+        lanes[out[i]] = result[0];
+        lanes[out[i + 1]] = result[1];
+        lanes[out[i + 2]] = result[2];
+        lanes[out[i + 3]] = result[3];
+    }
+    for (; i < count; ++i) lanes[out[i]] = ~lanes[in[i]];
+}
+
+const GateKernels avx2Kernels = { "avx2", Avx2And, Avx2Or, Avx2Not, Avx2Xor };
+
+// AVX-512F gathers eight gates per iteration. Results are stored with
+// plain moves: scatter was measurably slower than scalar stores. The masked
+// gather form avoids reading an uninitialised merge source.
+LCS_TARGET("avx512f") inline __m512i Gather8(const uint64_t* lanes, const NetId* index) {
+    __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index));
+    return _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xFF, offsets, lanes, 8);
+}
+
+#define LCS_AVX512_BINARY_KERNEL(name, op, scalarOp)                                                         \
+    LCS_TARGET("avx512f") void name(uint64_t* lanes, const NetId* in0, const NetId* in1, const NetId* out, size_t count) { \
+        size_t i = 0;                                                                                        \
+        for (; i + 8 <= count; i += 8) {                                                                     \
+            __m512i a = Gather8(lanes, in0 + i);                                                             \
+            __m512i b = Gather8(lanes, in1 + i);                                                             \
+            alignas(64) uint64_t result[8];                                                                  \
+            _mm512_store_si512(result, op(a, b));                                                            \
+            for (int k = 0; k < 8; ++k) lanes[out[i + k]] = result[k];                                       \
+        }                                                                                                    \
+        for (; i < count; ++i) lanes[out[i]] = lanes[in0[i]] scalarOp lanes[in1[i]];                        \
+    }
+
+LCS_AVX512_BINARY_KERNEL(Avx512And, _mm512_and_si512, &)
+LCS_AVX512_BINARY_KERNEL(Avx512Or, _mm512_or_si512, |)
+LCS_AVX512_BINARY_KERNEL(Avx512Xor, _mm512_xor_si512, ^)
+
+LCS_TARGET("avx512f") void Avx512Not(uint64_t* lanes, const NetId* in, const NetId* out, size_t count) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i a = Gather8(lanes, in + i);
+        alignas(64) uint64_t result[8];
+        _mm512_store_si512(result, _mm512_xor_si512(a, ones));
+        for (int k = 0; k < 8; ++k) lanes[out[i + k]] = result[k];
+    }
+    for (; i < count; ++i) lanes[out[i]] = ~lanes[in[i]];
+}
+
+const GateKernels avx512Kernels = { "avx512", Avx512And, Avx512Or, Avx512Not, Avx512Xor };
+
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+SimdLevel DetectSimdLevel() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || maxLeaf < 7) return SimdLevel::SCALAR;
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+    bool avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+#else
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2");
+    bool avx512 = __builtin_cpu_supports("avx512f");
+#endif
+    if (avx512) return SimdLevel::AVX512;
+    if (avx2) return SimdLevel::AVX2;
+    return SimdLevel::SCALAR;
+}
+
+#endif // LCS_X86_KERNELS
+
+const GateKernels& SelectGateKernels() {
+#ifdef LCS_X86_KERNELS
+    SimdLevel level = DetectSimdLevel();
+    const char* cap = std::getenv("LCS_SIMD");
+    if (cap && std::strcmp(cap, "scalar") == 0) level = SimdLevel::SCALAR;
+    if (cap && std::strcmp(cap, "avx2") == 0 && level == SimdLevel::AVX512) level = SimdLevel::AVX2;
+
+    switch (level) {
+        case SimdLevel::AVX512: return avx512Kernels;
+        case SimdLevel::AVX2: return avx2Kernels;
+        case SimdLevel::SCALAR: break;
+    }
+#endif
+    return scalarKernels;
+}
+
+} // namespace
+
+const GateKernels& GetGateKernels() {
+    static const GateKernels& kernels = SelectGateKernels();
+    return kernels;
+}
+
+const GateKernels& GetScalarGateKernels() {
+    return scalarKernels;
+}
@@ -0,0 +1,27 @@
+#ifndef GATE_KERNELS_H
+#define GATE_KERNELS_H
+
+#include "Netlist.h"
+#include <cstddef>
+#include <cstdint>
+
+// Kernels that evaluate a run of same-kind gates over 64-lane net words.
+// Run i reads lanes[in0[i]] (and lanes[in1[i]]) and writes lanes[out[i]].
+// Gates within a run must be independent of each other.
+struct GateKernels {
+    using BinaryKernel = void (*)(uint64_t* lanes, const NetId* in0, const NetId* in1, const NetId* out, size_t count);
+    using UnaryKernel = void (*)(uint64_t* lanes, const NetId* in, const NetId* out, size_t count);
+
+    const char* name;
+    BinaryKernel evalAnd;
+    BinaryKernel evalOr;
+    UnaryKernel evalNot;
+    BinaryKernel evalXor;
+};
+
+// Best kernel set for the running CPU (AVX-512, AVX2 or scalar), chosen once
+// through CPUID. Setting LCS_SIMD=scalar|avx2|avx512 caps the choice.
+const GateKernels& GetGateKernels();
+const GateKernels& GetScalarGateKernels();
+
+#endif // GATE_KERNELS_H
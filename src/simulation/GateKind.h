@@ -0,0 +1,24 @@
+#ifndef GATE_KIND_H
+#define GATE_KIND_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Primitive gate kinds understood by the simulation core.
+// NONE marks a free gate slot in the netlist.
+enum class GateKind : uint8_t {
+    NONE,
+    INPUT,  // Externally driven source (e.g. an InputSwitch)
+    AND,
+    OR,
+    NOT,
+    XOR,        // Odd parity of any number of inputs
+    SUBCIRCUIT  // One port of a subcircuit instance (see Subcircuit.h)
+};
+
+// Number of GateKind values; bump it when adding a kind
+constexpr size_t GATE_KIND_COUNT = static_cast<size_t>(GateKind::SUBCIRCUIT) + 1;
+
+const char* GetGateKindName(GateKind kind);
+
+#endif // GATE_KIND_H
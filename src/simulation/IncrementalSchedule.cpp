@@ -0,0 +1,194 @@
+#include "IncrementalSchedule.h"
+#include "GateEvaluation.h"
+#include "Levelizer.h"
+#include "Subcircuit.h"
+#include <algorithm>
+
+void IncrementalSchedule::Update(const Netlist& netlist) {
+    if (IsCurrent(netlist)) return;
+
+    edits.clear();
+    bool patched = version != UINT64_MAX && netlist.GetEditsSince(version, edits) && Patch(netlist);
+    if (!patched) {
+        Rebuild(netlist);
+    }
+    version = netlist.GetTopologyVersion();
+}
+
+void IncrementalSchedule::Evaluate(const Netlist& netlist, uint8_t* values) const {
+    const uint8_t* inputValues = netlist.GetInputValueData();
+    const NetId* fanin = netlist.GetFaninData();
+    for (const LevelBuckets& level : levels) {
+        for (size_t kind = 0; kind < GATE_KIND_COUNT; ++kind) {
+            const std::vector<CompiledGate>& bucket = level[kind];
+            if (bucket.empty()) continue;
+            if (kind == static_cast<size_t>(GateKind::SUBCIRCUIT)) {
+                EvaluateSubcircuitGates(netlist, values, fanin, bucket.data(), bucket.data() + bucket.size());
+            } else {
+                GATE_RUN_TABLE[kind](inputValues, values, fanin, bucket.data(), bucket.data() + bucket.size());
+            }
+        }
+    }
+    EvaluateCompiledGates(netlist, values, fanin, cyclicGates.data(), cyclicGates.data() + cyclicGates.size());
+}
+
+void IncrementalSchedule::Rebuild(const Netlist& netlist) {
+    Levelization levelization = Levelize(netlist);
+
+    levels.clear();
+    cyclicGates.clear();
+    gateLevels.assign(netlist.GetGateCount(), UNPLACED);
+    placedKinds.assign(netlist.GetGateCount(), GateKind::NONE);
+    bucketIndices.assign(netlist.GetGateCount(), 0);
+    for (uint32_t level = 0; level < levelization.GetLevelCount(); ++level) {
+        for (uint32_t i = levelization.levelOffsets[level]; i < levelization.levelOffsets[level + 1]; ++i) {
+            Place(netlist, levelization.order[i], level);
+        }
+    }
+    for (GateId gate : levelization.cyclicGates) {
+        Place(netlist, gate, CYCLIC_LEVEL);
+    }
+
+    lastUpdateSize = netlist.GetLiveGateCount();
+    lastUpdateRebuild = true;
+}
+
+bool IncrementalSchedule::Patch(const Netlist& netlist) {
+    Resize(netlist);
+    const size_t budget = std::max<size_t>(1024, netlist.GetLiveGateCount() / REBUILD_DIVISOR);
+
+    // Everything downstream of an edited gate may change level
+    cone.clear();
+    for (GateId gate : edits) {
+        if (!netlist.IsValidGate(gate)) {
+            Unplace(gate);
+            continue;
+        }
+        if (inCone[gate]) continue;
+        inCone[gate] = 1;
+        cone.push_back(gate);
+    }
+    for (size_t i = 0; i < cone.size(); ++i) {
+        for (GateId reader : netlist.GetFanout(netlist.GetOutput(cone[i]))) {
+            if (!inCone[reader]) {
+                inCone[reader] = 1;
+                cone.push_back(reader);
+            }
+        }
+        if (cone.size() > budget) {
+            for (GateId gate : cone) inCone[gate] = 0;
+            return false;
+        }
+    }
+
+    // Kahn's algorithm over the cone; drivers outside it keep their levels
+    ready.clear();
+    for (GateId gate : cone) {
+        uint32_t count = 0;
+        for (NetId net : netlist.GetFanin(gate)) {
+            GateId driver = netlist.GetDriver(net);
+            if (driver != INVALID_GATE && inCone[driver]) ++count;
+        }
+        pending[gate] = count;
+        if (count == 0) ready.push_back(gate);
+    }
+    for (size_t i = 0; i < ready.size(); ++i) {
+        GateId gate = ready[i];
+        uint32_t level = 0;
+        for (NetId net : netlist.GetFanin(gate)) {
+            GateId driver = netlist.GetDriver(net);
+            if (driver == INVALID_GATE) continue;
+            if (gateLevels[driver] == CYCLIC_LEVEL) {
+                level = CYCLIC_LEVEL;
+                break;
+            }
+            level = std::max(level, gateLevels[driver] + 1);
+        }
+        Unplace(gate);
+        Place(netlist, gate, level);
+
+        for (GateId reader : netlist.GetFanout(netlist.GetOutput(gate))) {
+            if (inCone[reader] && --pending[reader] == 0) {
+                ready.push_back(reader);
+            }
+        }
+    }
+
+    // Whatever Kahn could not reach is on or behind a loop
+    for (GateId gate : cone) {
+        if (pending[gate] != 0) {
+            Unplace(gate);
+            Place(netlist, gate, CYCLIC_LEVEL);
+        }
+        inCone[gate] = 0;
+    }
+
+    while (!levels.empty() && std::all_of(levels.back().begin(), levels.back().end(),
+                                          [](const std::vector<CompiledGate>& bucket) { return bucket.empty(); })) {
+        levels.pop_back();
+    }
+
+    lastUpdateSize = cone.size();
+    lastUpdateRebuild = false;
+    return true;
+}
+
+void IncrementalSchedule::Resize(const Netlist& netlist) {
+    size_t gateCount = netlist.GetGateCount();
+    if (gateLevels.size() < gateCount) {
+        gateLevels.resize(gateCount, UNPLACED);
+        placedKinds.resize(gateCount, GateKind::NONE);
+        bucketIndices.resize(gateCount, 0);
+    }
+    if (inCone.size() < gateCount) {
+        inCone.resize(gateCount, 0);
+        pending.resize(gateCount, 0);
+    }
+}
+
+void IncrementalSchedule::Place(const Netlist& netlist, GateId gate, uint32_t level) {
+    CompiledGate op{
+        netlist.GetKind(gate),
+        netlist.GetFaninBegin(gate),
+        static_cast<uint32_t>(netlist.GetFanin(gate).size()),
+        netlist.GetOutput(gate),
+        gate
+    };
+    gateLevels[gate] = level;
+    placedKinds[gate] = op.kind;
+
+    if (level == CYCLIC_LEVEL) {
+        auto position = std::lower_bound(cyclicGates.begin(), cyclicGates.end(), gate,
+                                         [](const CompiledGate& entry, GateId g) { return entry.gate < g; });
+        cyclicGates.insert(position, op);
+        return;
+    }
+
+    if (level >= levels.size()) {
+        levels.resize(level + 1);
+    }
+    std::vector<CompiledGate>& bucket = levels[level][static_cast<size_t>(op.kind)];
+    bucketIndices[gate] = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(op);
+}
+
+void IncrementalSchedule::Unplace(GateId gate) {
+    if (gate >= gateLevels.size()) return;
+    uint32_t level = gateLevels[gate];
+    if (level == UNPLACED) return;
+    gateLevels[gate] = UNPLACED;
+
+    if (level == CYCLIC_LEVEL) {
+        auto position = std::lower_bound(cyclicGates.begin(), cyclicGates.end(), gate,
+                                         [](const CompiledGate& entry, GateId g) { return entry.gate < g; });
+        cyclicGates.erase(position);
+        return;
+    }
+
+    // Swap the last entry into the hole
+    std::vector<CompiledGate>& bucket = levels[level][static_cast<size_t>(placedKinds[gate])];
+    uint32_t index = bucketIndices[gate];
+    bucket[index] = bucket.back();
+    bucketIndices[bucket[index].gate] = index;
+    bucket.pop_back();
+}
@@ -0,0 +1,69 @@
+#ifndef INCREMENTAL_SCHEDULE_H
+#define INCREMENTAL_SCHEDULE_H
+
+#include "CompiledNetlist.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Levelized evaluation order that is patched in place as the netlist is
+// edited. Compiled gates live in one bucket per level and kind; after an
+// edit only the fanout cone of the touched gates is re-levelized (Kahn's
+// algorithm restricted to the cone) and moved between buckets. Gates on or
+// downstream of a loop sit in a separate list kept in slot order. When the
+// edit journal has been dropped, or a cone covers much of the design, the
+// schedule is rebuilt from scratch instead.
+class IncrementalSchedule {
+public:
+    static constexpr uint32_t CYCLIC_LEVEL = UINT32_MAX;
+
+    // Brings the schedule up to the netlist's topology version
+    void Update(const Netlist& netlist);
+    bool IsCurrent(const Netlist& netlist) const { return version == netlist.GetTopologyVersion(); }
+
+    // Evaluates every scheduled gate once, level by level
+    void Evaluate(const Netlist& netlist, uint8_t* values) const;
+
+    size_t GetLevelCount() const { return levels.size(); }
+    size_t GetCyclicGateCount() const { return cyclicGates.size(); }
+    // CYCLIC_LEVEL for gates in or after a loop
+    uint32_t GetGateLevel(GateId gate) const { return gateLevels[gate]; }
+
+    // Gates re-levelized by the last update, and whether it was a full rebuild
+    size_t GetLastUpdateSize() const { return lastUpdateSize; }
+    bool WasLastUpdateRebuild() const { return lastUpdateRebuild; }
+
+private:
+    static constexpr uint32_t UNPLACED = UINT32_MAX - 1;
+    // Cones larger than this share of live gates are cheaper to rebuild
+    static constexpr size_t REBUILD_DIVISOR = 4;
+
+    using LevelBuckets = std::array<std::vector<CompiledGate>, GATE_KIND_COUNT>;
+
+    void Rebuild(const Netlist& netlist);
+    bool Patch(const Netlist& netlist);
+    void Resize(const Netlist& netlist);
+    void Place(const Netlist& netlist, GateId gate, uint32_t level);
+    void Unplace(GateId gate);
+
+    std::vector<LevelBuckets> levels;
+    std::vector<CompiledGate> cyclicGates;
+
+    // Per gate slot: level, and the kind and index of its bucket entry
+    std::vector<uint32_t> gateLevels;
+    std::vector<GateKind> placedKinds;
+    std::vector<uint32_t> bucketIndices;
+
+    // Scratch for Patch
+    std::vector<GateId> edits;
+    std::vector<GateId> cone;
+    std::vector<GateId> ready;
+    std::vector<uint32_t> pending;
+    std::vector<uint8_t> inCone;
+
+    uint64_t version = UINT64_MAX;
+    size_t lastUpdateSize = 0;
+    bool lastUpdateRebuild = false;
+};
+
+#endif // INCREMENTAL_SCHEDULE_H
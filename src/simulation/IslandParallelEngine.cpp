@@ -0,0 +1,72 @@
+#include "IslandParallelEngine.h"
+#include "Islands.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+IslandParallelEngine::IslandParallelEngine(ThreadPool& pool) : pool(pool) {}
+
+void IslandParallelEngine::Step(Netlist& netlist) {
+    if (!compiled.IsCurrent(netlist)) {
+        Rebuild(netlist);
+    }
+
+    uint8_t* values = netlist.GetValueData();
+    const NetId* fanin = compiled.GetFanin().data();
+    const CompiledGate* gates = binGates.data();
+    if (GetBinCount() < 2 || binGates.size() < PARALLEL_THRESHOLD) {
+        EvaluateCompiledGates(netlist, values, fanin, gates, gates + binGates.size());
+    } else {
+        pool.ParallelFor(GetBinCount(), [&](size_t bin) {
+            EvaluateCompiledGates(netlist, values, fanin, gates + binOffsets[bin], gates + binOffsets[bin + 1]);
+        });
+    }
+    netlist.ClearDirtyGates();
+}
+
+void IslandParallelEngine::Rebuild(const Netlist& netlist) {
+    compiled.Compile(netlist);
+    IslandPartition partition = FindIslands(netlist);
+    islandCount = partition.GetIslandCount();
+
+    // Longest-processing-time packing: biggest island into the lightest bin
+    size_t binCount = std::min<size_t>(islandCount, pool.GetThreadCount() * BINS_PER_THREAD);
+    binCount = std::max<size_t>(binCount, 1);
+
+    std::vector<uint32_t> islandOrder(islandCount);
+    std::iota(islandOrder.begin(), islandOrder.end(), 0);
+    std::stable_sort(islandOrder.begin(), islandOrder.end(), [&](uint32_t a, uint32_t b) {
+        return partition.islandSizes[a] > partition.islandSizes[b];
+    });
+
+    using BinLoad = std::pair<uint64_t, uint32_t>;
+    std::priority_queue<BinLoad, std::vector<BinLoad>, std::greater<BinLoad>> loads;
+    for (uint32_t bin = 0; bin < binCount; ++bin) {
+        loads.push({ 0, bin });
+    }
+    std::vector<uint32_t> islandBins(islandCount);
+    for (uint32_t island : islandOrder) {
+        BinLoad lightest = loads.top();
+        loads.pop();
+        islandBins[island] = lightest.second;
+        lightest.first += partition.islandSizes[island];
+        loads.push(lightest);
+    }
+
+    // Stable counting sort of the compiled gates by bin keeps dependency order
+    const std::vector<CompiledGate>& gates = compiled.GetGates();
+    binOffsets.assign(binCount + 1, 0);
+    for (const CompiledGate& op : gates) {
+        ++binOffsets[islandBins[partition.gateIslands[op.gate]] + 1];
+    }
+    for (size_t bin = 0; bin < binCount; ++bin) {
+        binOffsets[bin + 1] += binOffsets[bin];
+    }
+    std::vector<uint32_t> cursors(binOffsets.begin(), binOffsets.end() - 1);
+    binGates.resize(gates.size());
+    for (const CompiledGate& op : gates) {
+        binGates[cursors[islandBins[partition.gateIslands[op.gate]]]++] = op;
+    }
+}
@@ -0,0 +1,56 @@
+#include "Islands.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+GateId FindRoot(std::vector<GateId>& parents, GateId gate) {
+    while (parents[gate] != gate) {
+        parents[gate] = parents[parents[gate]];
+        gate = parents[gate];
+    }
+    return gate;
+}
+
+} // namespace
+
+IslandPartition FindIslands(const Netlist& netlist) {
+    const size_t gateCount = netlist.GetGateCount();
+    std::vector<GateId> parents(gateCount);
+    std::vector<uint32_t> ranks(gateCount, 0);
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        parents[gate] = gate;
+    }
+
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (!netlist.IsValidGate(gate)) continue;
+        for (NetId net : netlist.GetFanin(gate)) {
+            GateId driver = netlist.GetDriver(net);
+            if (driver == INVALID_GATE) continue;
+
+            GateId a = FindRoot(parents, gate);
+            GateId b = FindRoot(parents, driver);
+            if (a == b) continue;
+            if (ranks[a] < ranks[b]) std::swap(a, b);
+            parents[b] = a;
+            if (ranks[a] == ranks[b]) ++ranks[a];
+        }
+    }
+
+    // Number islands in order of their lowest gate slot
+    IslandPartition partition;
+    partition.gateIslands.assign(gateCount, NO_ISLAND);
+    std::vector<uint32_t>& rootIslands = ranks;
+    std::fill(rootIslands.begin(), rootIslands.end(), NO_ISLAND);
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (!netlist.IsValidGate(gate)) continue;
+        GateId root = FindRoot(parents, gate);
+        if (rootIslands[root] == NO_ISLAND) {
+            rootIslands[root] = static_cast<uint32_t>(partition.islandSizes.size());
+            partition.islandSizes.push_back(0);
+        }
+        partition.gateIslands[gate] = rootIslands[root];
+        ++partition.islandSizes[rootIslands[root]];
+    }
+    return partition;
+}
@@ -0,0 +1,23 @@
+#ifndef ISLANDS_H
+#define ISLANDS_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <vector>
+
+constexpr uint32_t NO_ISLAND = UINT32_MAX;
+
+// Electrically independent parts of a netlist. Two gates share an island
+// when a net connects them, directly or through other gates. Constant nets
+// do not join islands, since nothing drives them.
+struct IslandPartition {
+    std::vector<uint32_t> gateIslands;  // island per gate slot, NO_ISLAND for free slots
+    std::vector<uint32_t> islandSizes;  // live gates per island
+
+    size_t GetIslandCount() const { return islandSizes.size(); }
+};
+
+// Union-find over every gate-to-driver connection
+IslandPartition FindIslands(const Netlist& netlist);
+
+#endif // ISLANDS_H
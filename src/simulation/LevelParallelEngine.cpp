@@ -0,0 +1,57 @@
+#include "LevelParallelEngine.h"
+#include <algorithm>
+
+LevelParallelEngine::LevelParallelEngine(ThreadPool& pool) : pool(pool) {}
+
+size_t LevelParallelEngine::GetParallelLevelCount() const {
+    return std::count_if(segments.begin(), segments.end(), [](const Segment& segment) { return segment.parallel; });
+}
+
+void LevelParallelEngine::Step(Netlist& netlist) {
+    if (!compiled.IsCurrent(netlist)) {
+        compiled.Compile(netlist);
+        Plan();
+    }
+
+    uint8_t* values = netlist.GetValueData();
+    const NetId* fanin = compiled.GetFanin().data();
+    const CompiledGate* gates = compiled.GetGates().data();
+    for (const Segment& segment : segments) {
+        if (!segment.parallel) {
+            EvaluateCompiledGates(netlist, values, fanin, gates + segment.begin, gates + segment.end);
+            continue;
+        }
+
+        uint32_t chunks = (segment.end - segment.begin + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        pool.ParallelFor(chunks, [&](size_t chunk) {
+            uint32_t begin = segment.begin + static_cast<uint32_t>(chunk) * CHUNK_SIZE;
+            uint32_t end = std::min(begin + CHUNK_SIZE, segment.end);
+            EvaluateCompiledGates(netlist, values, fanin, gates + begin, gates + end);
+        });
+    }
+    netlist.ClearDirtyGates();
+}
+
+void LevelParallelEngine::Plan() {
+    // Each wide level is its own parallel segment; everything between them
+    // merges into serial segments
+    segments.clear();
+    const std::vector<uint32_t>& levelOffsets = compiled.GetLevelOffsets();
+    const bool useThreads = pool.GetThreadCount() > 1;
+    for (size_t level = 0; level < compiled.GetLevelCount(); ++level) {
+        uint32_t begin = levelOffsets[level];
+        uint32_t end = levelOffsets[level + 1];
+        bool parallel = useThreads && end - begin >= PARALLEL_THRESHOLD;
+        if (!parallel && !segments.empty() && !segments.back().parallel) {
+            segments.back().end = end;
+        } else {
+            segments.push_back({ begin, end, parallel });
+        }
+    }
+
+    uint32_t cyclicBegin = levelOffsets.empty() ? 0 : levelOffsets.back();
+    uint32_t gateCount = static_cast<uint32_t>(compiled.GetGates().size());
+    if (cyclicBegin < gateCount) {
+        segments.push_back({ cyclicBegin, gateCount, false });
+    }
+}
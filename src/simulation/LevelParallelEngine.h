@@ -0,0 +1,44 @@
+#ifndef LEVEL_PARALLEL_ENGINE_H
+#define LEVEL_PARALLEL_ENGINE_H
+
+#include "Engine.h"
+#include "CompiledNetlist.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+// Compiled-code simulation that parallelizes inside one island. Gates on
+// the same topological level never read each other, so each wide level is
+// cut into chunks that the work-stealing pool spreads over its threads, and
+// the next level starts only once the whole level is done. Runs of narrow
+// levels, and the gates caught in combinational loops, stay serial.
+class LevelParallelEngine : public Engine {
+public:
+    explicit LevelParallelEngine(ThreadPool& pool = ThreadPool::GetShared());
+
+    const char* GetName() const override { return "Level-parallel"; }
+    void Step(Netlist& netlist) override;
+
+    size_t GetLevelCount() const { return compiled.GetLevelCount(); }
+    size_t GetParallelLevelCount() const;
+
+private:
+    static constexpr uint32_t CHUNK_SIZE = 512;
+    // Levels narrower than this are cheaper to run than to hand out
+    static constexpr uint32_t PARALLEL_THRESHOLD = 2 * CHUNK_SIZE;
+
+    // Gates [begin, end) of the compiled order, run serially or in chunks
+    struct Segment {
+        uint32_t begin;
+        uint32_t end;
+        bool parallel;
+    };
+
+    void Plan();
+
+    ThreadPool& pool;
+    CompiledNetlist compiled;
+    std::vector<Segment> segments;
+};
+
+#endif // LEVEL_PARALLEL_ENGINE_H
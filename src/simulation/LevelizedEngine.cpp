@@ -0,0 +1,7 @@
+#include "LevelizedEngine.h"
+
+void LevelizedEngine::Step(Netlist& netlist) {
+    schedule.Update(netlist);
+    schedule.Evaluate(netlist, netlist.GetValueData());
+    netlist.ClearDirtyGates();
+}
@@ -0,0 +1,27 @@
+#ifndef LEVELIZED_ENGINE_H
+#define LEVELIZED_ENGINE_H
+
+#include "Engine.h"
+#include "IncrementalSchedule.h"
+
+// Compiled-code simulation: the netlist is levelized and flattened into
+// arrays of gate records in dependency order, so one linear pass settles
+// every combinational path. Each level is grouped by gate kind and every
+// group runs through a loop specialized for that kind, with no per-gate
+// dispatch. Gates caught in a combinational loop run after the ordered ones
+// in slot order, as the sweep engine would. Edits re-levelize only the
+// fanout cone they touch, so editing stays cheap on large designs.
+class LevelizedEngine : public Engine {
+public:
+    const char* GetName() const override { return "Levelized"; }
+    void Step(Netlist& netlist) override;
+
+    size_t GetLevelCount() const { return schedule.GetLevelCount(); }
+    size_t GetCyclicGateCount() const { return schedule.GetCyclicGateCount(); }
+    const IncrementalSchedule& GetSchedule() const { return schedule; }
+
+private:
+    IncrementalSchedule schedule;
+};
+
+#endif // LEVELIZED_ENGINE_H
@@ -0,0 +1,42 @@
+#include "Levelizer.h"
+
+Levelization Levelize(const Netlist& netlist) {
+    Levelization result;
+    size_t gateCount = netlist.GetGateCount();
+
+    // Kahn's algorithm, one frontier per level so levels follow the longest path
+    std::vector<uint32_t> pending(gateCount, 0);
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (netlist.GetKind(gate) == GateKind::NONE) continue;
+        uint32_t count = 0;
+        for (NetId net : netlist.GetFanin(gate)) {
+            if (net > Netlist::CONST1) ++count;
+        }
+        pending[gate] = count;
+        if (count == 0) {
+            result.order.push_back(gate);
+        }
+    }
+
+    size_t levelBegin = 0;
+    while (levelBegin < result.order.size()) {
+        size_t levelEnd = result.order.size();
+        result.levelOffsets.push_back(static_cast<uint32_t>(levelBegin));
+        for (size_t i = levelBegin; i < levelEnd; ++i) {
+            for (GateId reader : netlist.GetFanout(netlist.GetOutput(result.order[i]))) {
+                if (--pending[reader] == 0) {
+                    result.order.push_back(reader);
+                }
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    result.levelOffsets.push_back(static_cast<uint32_t>(result.order.size()));
+
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (netlist.GetKind(gate) != GateKind::NONE && pending[gate] != 0) {
+            result.cyclicGates.push_back(gate);
+        }
+    }
+    return result;
+}
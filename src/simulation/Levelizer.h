@@ -0,0 +1,21 @@
+#ifndef LEVELIZER_H
+#define LEVELIZER_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <vector>
+
+// Topological ordering of a netlist's gates. A gate's level is one more
+// than the deepest gate driving it; gates reading only constants or
+// nothing at all sit on level 0.
+struct Levelization {
+    std::vector<GateId> order;           // acyclic gates sorted by level
+    std::vector<uint32_t> levelOffsets;  // level l is order[levelOffsets[l], levelOffsets[l + 1])
+    std::vector<GateId> cyclicGates;     // gates on or downstream of a combinational loop
+
+    size_t GetLevelCount() const { return levelOffsets.empty() ? 0 : levelOffsets.size() - 1; }
+};
+
+Levelization Levelize(const Netlist& netlist);
+
+#endif // LEVELIZER_H
@@ -0,0 +1,152 @@
+#include "NativeCompiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Gates per generated function; keeps compile time per function bounded
+constexpr size_t GATES_PER_FUNCTION = 4096;
+
+std::string ReadFile(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+} // namespace
+
+std::string GenerateNativeSource(const CompiledNetlist& compiled) {
+    const std::vector<CompiledGate>& gates = compiled.GetGates();
+    const std::vector<NetId>& fanin = compiled.GetFanin();
+
+    std::string source;
+    source.reserve(gates.size() * 32 + 256);
+    source += "// Generated by LogicCircuitSimulator; do not edit\n";
+    source += "#include <cstdint>\n\n";
+    source += "#define LCS_SETTLE_ARGS uint8_t* __restrict v, const uint8_t* __restrict in\n\n";
+
+    size_t functionCount = 0;
+    for (size_t begin = 0; begin < gates.size(); begin += GATES_PER_FUNCTION) {
+        size_t end = std::min(begin + GATES_PER_FUNCTION, gates.size());
+        source += "static void settle" + std::to_string(functionCount++) + "(LCS_SETTLE_ARGS) {\n";
+        for (size_t i = begin; i < end; ++i) {
+            const CompiledGate& op = gates[i];
+            const NetId* in = fanin.data() + op.faninBegin;
+            source += "    v[" + std::to_string(op.output) + "] = ";
+            switch (op.kind) {
+                case GateKind::INPUT:
+                    source += "in[" + std::to_string(op.gate) + "]";
+                    break;
+                case GateKind::AND:
+                case GateKind::OR:
+                case GateKind::XOR:
+                    if (op.faninCount == 0) {
+                        source += "0";
+                    }
+                    for (uint32_t pin = 0; pin < op.faninCount; ++pin) {
+                        if (pin > 0) source += op.kind == GateKind::AND ? " & " : op.kind == GateKind::OR ? " | " : " ^ ";
+                        source += "v[" + std::to_string(in[pin]) + "]";
+                    }
+                    break;
+                case GateKind::NOT:
+                    source += "v[" + std::to_string(in[0]) + "] ^ 1";
+                    break;
+                case GateKind::SUBCIRCUIT:
+                    // NativeEngine never builds netlists holding subcircuits
+                case GateKind::NONE:
+                    source += "0";
+                    break;
+            }
+            source += ";\n";
+        }
+        source += "}\n\n";
+    }
+
+    source += "extern \"C\" void lcs_settle(LCS_SETTLE_ARGS) {\n";
+    for (size_t i = 0; i < functionCount; ++i) {
+        source += "    settle" + std::to_string(i) + "(v, in);\n";
+    }
+    source += "}\n";
+    return source;
+}
+
+#if defined(_WIN32)
+
+NativeModule::~NativeModule() {}
+
+std::unique_ptr<NativeModule> NativeModule::Build(const std::string&, std::string& error) {
+    error = "native compilation is not supported on this platform";
+    return nullptr;
+}
+
+#else
+
+NativeModule::~NativeModule() {
+    dlclose(handle);
+}
+
+std::unique_ptr<NativeModule> NativeModule::Build(const std::string& source, std::string& error) {
+    static std::atomic<unsigned> buildCount{0};
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path directory = fs::temp_directory_path(ec);
+    if (ec) {
+        error = "no temporary directory: " + ec.message();
+        return nullptr;
+    }
+    std::string stem = "lcs_native_" + std::to_string(getpid()) + "_" + std::to_string(buildCount++);
+    fs::path sourcePath = directory / (stem + ".cpp");
+    fs::path libraryPath = directory / (stem + ".so");
+    fs::path logPath = directory / (stem + ".log");
+
+    {
+        std::ofstream file(sourcePath);
+        file << source;
+        if (!file) {
+            error = "could not write " + sourcePath.string();
+            return nullptr;
+        }
+    }
+
+    const char* compiler = std::getenv("LCS_CXX");
+    if (!compiler) compiler = std::getenv("CXX");
+    if (!compiler) compiler = "c++";
+    std::string command = std::string("\"") + compiler + "\" -std=c++17 -O2 -shared -fPIC -o \"" +
+                          libraryPath.string() + "\" \"" + sourcePath.string() + "\" > \"" +
+                          logPath.string() + "\" 2>&1";
+    int status = std::system(command.c_str());
+
+    std::unique_ptr<NativeModule> module;
+    if (status != 0) {
+        error = "compiler failed: " + ReadFile(logPath);
+    } else if (void* handle = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL)) {
+        auto settle = reinterpret_cast<NativeSettleFunction>(dlsym(handle, "lcs_settle"));
+        if (settle) {
+            module.reset(new NativeModule(handle, settle));
+        } else {
+            error = "lcs_settle missing from generated library";
+            dlclose(handle);
+        }
+    } else {
+        error = dlerror();
+    }
+
+    // A loaded library stays mapped after its file is removed
+    fs::remove(sourcePath, ec);
+    fs::remove(libraryPath, ec);
+    fs::remove(logPath, ec);
+    return module;
+}
+
+#endif
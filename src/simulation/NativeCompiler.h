@@ -0,0 +1,40 @@
+#ifndef NATIVE_COMPILER_H
+#define NATIVE_COMPILER_H
+
+#include "CompiledNetlist.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Settles every net once: values holds one 0/1 byte per net, inputs one
+// 0/1 byte per gate slot for INPUT gates
+using NativeSettleFunction = void (*)(uint8_t* values, const uint8_t* inputs);
+
+// C++ source for a compiled netlist as straight-line code exporting
+// `lcs_settle`, matching NativeSettleFunction. SUBCIRCUIT gates are not
+// supported.
+std::string GenerateNativeSource(const CompiledNetlist& compiled);
+
+// A generated circuit built into a shared library with the system compiler
+// and loaded into the process. The compiler is taken from LCS_CXX, then
+// CXX, then `c++`. Only available where dlopen is.
+class NativeModule {
+public:
+    ~NativeModule();
+
+    NativeModule(const NativeModule&) = delete;
+    NativeModule& operator=(const NativeModule&) = delete;
+
+    // Blocks until the compiler finishes; returns null and fills error on failure
+    static std::unique_ptr<NativeModule> Build(const std::string& source, std::string& error);
+
+    NativeSettleFunction GetSettleFunction() const { return settle; }
+
+private:
+    NativeModule(void* handle, NativeSettleFunction settle) : handle(handle), settle(settle) {}
+
+    void* handle;
+    NativeSettleFunction settle;
+};
+
+#endif // NATIVE_COMPILER_H
@@ -0,0 +1,61 @@
+#include "NativeEngine.h"
+#include <thread>
+
+NativeEngine::~NativeEngine() {
+    // Engines are destroyed under the simulation lock, so a running compiler
+    // is left to finish (and clean up its temporary files) on its own thread
+    if (build.valid()) {
+        std::thread([pending = std::move(build)]() mutable { pending.wait(); }).detach();
+    }
+}
+
+const char* NativeEngine::GetName() const {
+    if (module) return "Native";
+    if (build.valid()) return "Native (building)";
+    return "Native (interpreted)";
+}
+
+void NativeEngine::Step(Netlist& netlist) {
+    if (!compiled.IsCurrent(netlist)) {
+        // Only edits after the first compile wait out the rebuild delay
+        bool firstCompile = compiled.GetNetCount() == 0;
+        compiled.Compile(netlist);
+        program.Compile(compiled);
+        module.reset();
+        lastEdit = firstCompile ? Clock::time_point{} : Clock::now();
+    }
+    UpdateBuild(netlist);
+
+    if (module) {
+        module->GetSettleFunction()(netlist.GetValueData(), netlist.GetInputValueData());
+    } else {
+        program.Run(netlist, netlist.GetValueData());
+    }
+    netlist.ClearDirtyGates();
+}
+
+void NativeEngine::UpdateBuild(const Netlist& netlist) {
+    const uint64_t version = netlist.GetTopologyVersion();
+
+    if (build.valid()) {
+        if (build.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+        BuildResult result = build.get();
+        buildError = std::move(result.error);
+        if (!result.module) {
+            failedVersion = result.version;
+        } else if (result.version == version) {
+            module = std::move(result.module);
+        }
+    }
+
+    if (module || version == failedVersion || Clock::now() - lastEdit < REBUILD_DELAY) return;
+    // Generated code cannot reach the shared definitions of subcircuits
+    if (netlist.GetSubcircuitCount() != 0) return;
+
+    build = std::async(std::launch::async, [source = GenerateNativeSource(compiled), version] {
+        BuildResult result;
+        result.module = NativeModule::Build(source, result.error);
+        result.version = version;
+        return result;
+    });
+}
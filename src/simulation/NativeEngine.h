@@ -0,0 +1,55 @@
+#ifndef NATIVE_ENGINE_H
+#define NATIVE_ENGINE_H
+
+#include "Engine.h"
+#include "Bytecode.h"
+#include "CompiledNetlist.h"
+#include "NativeCompiler.h"
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+
+// Runs the circuit as native code. The netlist is emitted as C++ and built
+// by the system compiler on a background thread while steps run on the
+// bytecode interpreter; the library is swapped in once it loads. Any
+// topology change drops back to the interpreter and, once edits have
+// settled for a moment, starts a fresh build. Netlists holding subcircuit
+// instances stay on the interpreter.
+class NativeEngine : public Engine {
+public:
+    ~NativeEngine() override;
+
+    const char* GetName() const override;
+    void Step(Netlist& netlist) override;
+
+    bool IsNative() const { return module != nullptr; }
+    bool IsBuilding() const { return build.valid(); }
+    // Compiler output of the last failed build, empty otherwise
+    const std::string& GetBuildError() const { return buildError; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct BuildResult {
+        std::unique_ptr<NativeModule> module;
+        std::string error;
+        uint64_t version;
+    };
+
+    // Edits must pause this long before a rebuild starts
+    static constexpr std::chrono::milliseconds REBUILD_DELAY{ 1000 };
+
+    void UpdateBuild(const Netlist& netlist);
+
+    CompiledNetlist compiled;
+    BytecodeProgram program;
+    std::unique_ptr<NativeModule> module;
+    std::future<BuildResult> build;
+    std::string buildError;
+    uint64_t failedVersion = UINT64_MAX;
+    Clock::time_point lastEdit{};
+};
+
+#endif // NATIVE_ENGINE_H
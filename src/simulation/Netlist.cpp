@@ -0,0 +1,320 @@
+#include "Netlist.h"
+#include "GateEvaluation.h"
+#include "Subcircuit.h"
+#include <algorithm>
+
+const char* GetGateKindName(GateKind kind) {
+    switch (kind) {
+        case GateKind::NONE: return "NONE";
+        case GateKind::INPUT: return "INPUT";
+        case GateKind::AND: return "AND";
+        case GateKind::OR: return "OR";
+        case GateKind::NOT: return "NOT";
+        case GateKind::XOR: return "XOR";
+        case GateKind::SUBCIRCUIT: return "SUBCIRCUIT";
+    }
+    return "UNKNOWN";
+}
+
+Netlist::Netlist() {
+    Clear();
+}
+
+void Netlist::Clear() {
+    gateKinds.clear();
+    faninBegin.clear();
+    faninCount.clear();
+    inputValues.clear();
+    gateDelays.clear();
+    gateFlags.clear();
+    gateSubcircuits.clear();
+    subcircuitPorts.clear();
+    probeCount = 0;
+    subcircuits.clear();
+    freeSubcircuits.clear();
+    fanin.clear();
+    pinGates.clear();
+    nextReaderPin.clear();
+    freeGates.clear();
+    freeGateCount = 0;
+    dirtyGates.clear();
+    netValues.assign(2, 0);
+    netValues[CONST1] = 1;
+    firstReaderPin.assign(2, NO_PIN);
+    ++topologyVersion;
+    editJournal.clear();
+    journalBaseVersion = topologyVersion;
+}
+
+void Netlist::ResetValues() {
+    std::fill(netValues.begin() + CONST1 + 1, netValues.end(), 0);
+    dirtyGates.clear();
+    for (GateId gate = 0; gate < gateKinds.size(); ++gate) {
+        if (gateKinds[gate] != GateKind::NONE) {
+            MarkDirty(gate);
+        }
+    }
+}
+
+void Netlist::LoadValues(const uint8_t* values) {
+    std::copy(values + CONST1 + 1, values + netValues.size(), netValues.begin() + CONST1 + 1);
+    dirtyGates.clear();
+    for (GateId gate = 0; gate < gateKinds.size(); ++gate) {
+        if (gateKinds[gate] == GateKind::INPUT) {
+            SetInputValue(gate, netValues[GetOutput(gate)] != 0);
+        }
+        if (gateKinds[gate] != GateKind::NONE) {
+            MarkDirty(gate);
+        }
+    }
+}
+
+GateId Netlist::AddGate(GateKind kind, int numInputs) {
+    GateId gate;
+    if (numInputs < static_cast<int>(freeGates.size()) && !freeGates[numInputs].empty()) {
+        gate = freeGates[numInputs].back();
+        freeGates[numInputs].pop_back();
+        --freeGateCount;
+    } else {
+        gate = static_cast<GateId>(gateKinds.size());
+        gateKinds.push_back(GateKind::NONE);
+        faninBegin.push_back(static_cast<uint32_t>(fanin.size()));
+        faninCount.push_back(static_cast<uint32_t>(numInputs));
+        inputValues.push_back(0);
+        gateDelays.push_back(DEFAULT_GATE_DELAY);
+        gateFlags.push_back(0);
+        gateSubcircuits.push_back(INVALID_SUBCIRCUIT);
+        subcircuitPorts.push_back(0);
+        fanin.insert(fanin.end(), numInputs, CONST0);
+        pinGates.insert(pinGates.end(), numInputs, gate);
+        nextReaderPin.insert(nextReaderPin.end(), numInputs, NO_PIN);
+        netValues.push_back(0);
+        firstReaderPin.push_back(NO_PIN);
+    }
+
+    gateKinds[gate] = kind;
+    inputValues[gate] = 0;
+    gateDelays[gate] = DEFAULT_GATE_DELAY;
+    gateFlags[gate] = 0;
+    gateSubcircuits[gate] = INVALID_SUBCIRCUIT;
+    netValues[GetOutput(gate)] = 0;
+
+    ++topologyVersion;
+    Journal(gate);
+    MarkDirty(gate);
+    return gate;
+}
+
+void Netlist::RemoveGate(GateId gate) {
+    if (!IsValidGate(gate)) return;
+    SubcircuitId instance = gateSubcircuits[gate];
+    if (instance == INVALID_SUBCIRCUIT) {
+        RemoveSlot(gate);
+        return;
+    }
+
+    for (GateId port : subcircuits[instance].ports) {
+        RemoveSlot(port);
+        gateSubcircuits[port] = INVALID_SUBCIRCUIT;
+    }
+    subcircuits[instance] = SubcircuitInstance();
+    freeSubcircuits.push_back(instance);
+}
+
+void Netlist::RemoveSlot(GateId gate) {
+    ++topologyVersion;
+    Journal(gate);
+
+    uint32_t begin = faninBegin[gate];
+    for (uint32_t pin = begin; pin < begin + faninCount[gate]; ++pin) {
+        UnlinkReader(fanin[pin], pin);
+        fanin[pin] = CONST0;
+    }
+
+    // Anything reading the removed gate now reads a constant low
+    NetId output = GetOutput(gate);
+    uint32_t pin = firstReaderPin[output];
+    while (pin != NO_PIN) {
+        uint32_t next = nextReaderPin[pin];
+        fanin[pin] = CONST0;
+        nextReaderPin[pin] = NO_PIN;
+        Journal(pinGates[pin]);
+        MarkDirty(pinGates[pin]);
+        pin = next;
+    }
+    firstReaderPin[output] = NO_PIN;
+
+    uint32_t arity = faninCount[gate];
+    if (arity >= freeGates.size()) {
+        freeGates.resize(arity + 1);
+    }
+    freeGates[arity].push_back(gate);
+    ++freeGateCount;
+
+    if (IsProbed(gate)) --probeCount;
+    gateKinds[gate] = GateKind::NONE;
+    gateFlags[gate] = 0;
+    inputValues[gate] = 0;
+    netValues[output] = 0;
+}
+
+void Netlist::ConnectInput(GateId gate, int pin, NetId net) {
+    if (!IsValidGate(gate) || pin < 0 || pin >= static_cast<int>(faninCount[gate])) return;
+    if (net >= netValues.size()) return;
+
+    SubcircuitId instance = gateSubcircuits[gate];
+    if (instance == INVALID_SUBCIRCUIT) {
+        ConnectPin(gate, pin, net);
+        return;
+    }
+    if (pin >= static_cast<int>(subcircuits[instance].definition->GetInputCount())) return;
+    for (GateId port : subcircuits[instance].ports) {
+        ConnectPin(port, pin, net);
+    }
+}
+
+void Netlist::ConnectPin(GateId gate, int pin, NetId net) {
+    uint32_t slot = faninBegin[gate] + pin;
+    if (fanin[slot] == net) return;
+    UnlinkReader(fanin[slot], slot);
+    fanin[slot] = net;
+    LinkReader(net, slot);
+
+    ++topologyVersion;
+    Journal(gate);
+    MarkDirty(gate);
+}
+
+void Netlist::DisconnectInput(GateId gate, int pin) {
+    ConnectInput(gate, pin, CONST0);
+}
+
+SubcircuitId Netlist::AddSubcircuit(std::shared_ptr<const SubcircuitDefinition> definition) {
+    if (!definition) return INVALID_SUBCIRCUIT;
+
+    SubcircuitId instance;
+    if (!freeSubcircuits.empty()) {
+        instance = freeSubcircuits.back();
+        freeSubcircuits.pop_back();
+    } else {
+        instance = static_cast<SubcircuitId>(subcircuits.size());
+        subcircuits.emplace_back();
+    }
+
+    const int inputCount = static_cast<int>(definition->GetInputCount());
+    const size_t stateBits = definition->GetStateBitCount();
+    const size_t portCount = definition->GetOutputCount() + stateBits;
+    std::vector<GateId> ports;
+    for (size_t port = 0; port < portCount; ++port) {
+        GateId gate = AddGate(GateKind::SUBCIRCUIT, inputCount + static_cast<int>(stateBits));
+        gateSubcircuits[gate] = instance;
+        subcircuitPorts[gate] = static_cast<uint32_t>(port);
+        ports.push_back(gate);
+    }
+    // Every port reads the current state; the state-bit ports compute the next
+    const size_t firstStatePort = portCount - stateBits;
+    for (GateId gate : ports) {
+        for (size_t bit = 0; bit < stateBits; ++bit) {
+            ConnectPin(gate, inputCount + static_cast<int>(bit), GetOutput(ports[firstStatePort + bit]));
+        }
+    }
+    subcircuits[instance] = { std::move(definition), std::move(ports) };
+    return instance;
+}
+
+void Netlist::SetInputValue(GateId gate, bool value) {
+    if (!IsValidGate(gate) || gateKinds[gate] != GateKind::INPUT) return;
+    if ((inputValues[gate] != 0) == value) return;
+    inputValues[gate] = value ? 1 : 0;
+    if (IsInputFixed(gate)) {
+        ++topologyVersion;
+        Journal(gate);
+    }
+    MarkDirty(gate);
+}
+
+void Netlist::SetInputFixed(GateId gate, bool fixed) {
+    if (!IsValidGate(gate) || gateKinds[gate] != GateKind::INPUT || IsInputFixed(gate) == fixed) return;
+    gateFlags[gate] ^= FLAG_FIXED;
+    ++topologyVersion;
+    Journal(gate);
+}
+
+void Netlist::SetProbed(GateId gate, bool probed) {
+    if (!IsValidGate(gate) || IsProbed(gate) == probed) return;
+    gateFlags[gate] ^= FLAG_PROBED;
+    probed ? ++probeCount : --probeCount;
+    ++topologyVersion;
+    Journal(gate);
+}
+
+void Netlist::SetGateDelay(GateId gate, uint32_t delay) {
+    if (!IsValidGate(gate)) return;
+    gateDelays[gate] = std::max<uint32_t>(delay, 1);
+}
+
+bool Netlist::Evaluate(GateId gate) const {
+    const NetId* in = fanin.data() + faninBegin[gate];
+    uint32_t count = faninCount[gate];
+    switch (gateKinds[gate]) {
+        case GateKind::INPUT:
+            return inputValues[gate] != 0;
+        case GateKind::AND:
+            return GateKernel<GateKind::AND>::Evaluate(netValues.data(), in, count, 0) != 0;
+        case GateKind::OR:
+            return GateKernel<GateKind::OR>::Evaluate(netValues.data(), in, count, 0) != 0;
+        case GateKind::NOT:
+            return !netValues[in[0]];
+        case GateKind::XOR:
+            return GateKernel<GateKind::XOR>::Evaluate(netValues.data(), in, count, 0) != 0;
+        case GateKind::SUBCIRCUIT:
+            return EvaluateSubcircuitPort(*this, gate, netValues.data()) != 0;
+        case GateKind::NONE:
+            break;
+    }
+    return false;
+}
+
+void Netlist::MarkDirty(GateId gate) {
+    dirtyGates.push_back(gate);
+}
+
+void Netlist::Journal(GateId gate) {
+    // Past a point replaying costs more than rebuilding, so start over
+    if (editJournal.size() >= gateKinds.size() + JOURNAL_SLACK) {
+        editJournal.clear();
+        journalBaseVersion = topologyVersion;
+        return;
+    }
+    editJournal.push_back({ topologyVersion, gate });
+}
+
+bool Netlist::GetEditsSince(uint64_t version, std::vector<GateId>& gates) const {
+    if (version < journalBaseVersion || version > topologyVersion) return false;
+    auto first = std::upper_bound(editJournal.begin(), editJournal.end(), version,
+                                  [](uint64_t v, const JournalEntry& entry) { return v < entry.version; });
+    for (auto it = first; it != editJournal.end(); ++it) {
+        gates.push_back(it->gate);
+    }
+    return true;
+}
+
+void Netlist::LinkReader(NetId net, uint32_t pin) {
+    // Constant nets never change, so their readers are not tracked
+    if (net <= CONST1) return;
+    nextReaderPin[pin] = firstReaderPin[net];
+    firstReaderPin[net] = pin;
+}
+
+void Netlist::UnlinkReader(NetId net, uint32_t pin) {
+    if (net <= CONST1) return;
+    uint32_t* link = &firstReaderPin[net];
+    while (*link != NO_PIN) {
+        if (*link == pin) {
+            *link = nextReaderPin[pin];
+            nextReaderPin[pin] = NO_PIN;
+            return;
+        }
+        link = &nextReaderPin[*link];
+    }
+}
@@ -0,0 +1,232 @@
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include "GateKind.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+using NetId = uint32_t;
+using GateId = uint32_t;
+using SubcircuitId = uint32_t;
+
+constexpr GateId INVALID_GATE = UINT32_MAX;
+constexpr SubcircuitId INVALID_SUBCIRCUIT = UINT32_MAX;
+
+class Netlist;
+class SubcircuitDefinition;
+
+// Gates reading a net, walked through the netlist's per-pin reader links.
+// A gate appears once per input pin connected to the net.
+class FanoutRange {
+public:
+    class Iterator {
+    public:
+        Iterator(const Netlist* netlist, uint32_t pin) : netlist(netlist), pin(pin) {}
+        GateId operator*() const;
+        Iterator& operator++();
+        bool operator!=(const Iterator& other) const { return pin != other.pin; }
+
+    private:
+        const Netlist* netlist;
+        uint32_t pin;
+    };
+
+    FanoutRange(const Netlist* netlist, uint32_t firstPin) : netlist(netlist), firstPin(firstPin) {}
+    Iterator begin() const { return Iterator(netlist, firstPin); }
+    Iterator end() const;
+    bool empty() const;
+
+private:
+    const Netlist* netlist;
+    uint32_t firstPin;
+};
+
+// Raylib-free description of a circuit: gates, the nets they drive and the
+// current logic value of every net. Every gate drives exactly one net, which
+// follows the two constant nets in slot order; gate inputs read nets. Gate
+// and net slots are recycled together after removal.
+//
+// Storage is structure-of-arrays with 32-bit indices: gate kinds, net values
+// and the packed fanin of every gate each live in one contiguous array, and
+// the readers of a net form a linked list threaded through the pin arrays so
+// edits never allocate per net.
+class Netlist {
+public:
+    // Reserved nets. Unconnected gate inputs read CONST0.
+    static constexpr NetId CONST0 = 0;
+    static constexpr NetId CONST1 = 1;
+    // Propagation delay of new gates, in simulation time units
+    static constexpr uint32_t DEFAULT_GATE_DELAY = 1;
+
+    Netlist();
+
+    GateId AddGate(GateKind kind, int numInputs);
+    // Removing any port of a subcircuit instance removes the whole instance
+    void RemoveGate(GateId gate);
+    // On a subcircuit port this rewires that input of every port of the
+    // instance; state pins cannot be rewired
+    void ConnectInput(GateId gate, int pin, NetId net);
+    void DisconnectInput(GateId gate, int pin);
+    void Clear();
+
+    // Adds an instance of a shared definition: one SUBCIRCUIT gate per output
+    // port, then one per state bit. Every port gate reads the instance's
+    // input pins followed by the nets of its state-bit gates, so instance
+    // state lives in ordinary nets and is reset, recorded and restored with
+    // them. Returns INVALID_SUBCIRCUIT for a null definition.
+    SubcircuitId AddSubcircuit(std::shared_ptr<const SubcircuitDefinition> definition);
+    // Port gates of an instance, outputs first, then state bits
+    std::span<const GateId> GetSubcircuitPorts(SubcircuitId instance) const { return subcircuits[instance].ports; }
+    const SubcircuitDefinition& GetSubcircuitDefinition(SubcircuitId instance) const { return *subcircuits[instance].definition; }
+    const std::shared_ptr<const SubcircuitDefinition>& GetSharedSubcircuitDefinition(SubcircuitId instance) const {
+        return subcircuits[instance].definition;
+    }
+    // Instance a SUBCIRCUIT gate belongs to, INVALID_SUBCIRCUIT for other gates
+    SubcircuitId GetSubcircuitOf(GateId gate) const { return gate < gateSubcircuits.size() ? gateSubcircuits[gate] : INVALID_SUBCIRCUIT; }
+    // Index of a SUBCIRCUIT gate among its instance's ports
+    uint32_t GetSubcircuitPort(GateId gate) const { return subcircuitPorts[gate]; }
+    size_t GetSubcircuitCount() const { return subcircuits.size() - freeSubcircuits.size(); }
+
+    // Drives every net low and schedules every gate for re-evaluation
+    void ResetValues();
+    // Overwrites every net value, one byte per net, and schedules every gate
+    // for re-evaluation. INPUT gates take the values of their nets.
+    void LoadValues(const uint8_t* values);
+
+    // Value driven by an INPUT gate
+    void SetInputValue(GateId gate, bool value);
+    bool GetInputValue(GateId gate) const { return inputValues[gate] != 0; }
+    // Fixed inputs hold their value for the run, so optimizers may fold them
+    // into constants; changing a fixed input's value counts as a structural edit
+    void SetInputFixed(GateId gate, bool fixed);
+    bool IsInputFixed(GateId gate) const { return (gateFlags[gate] & FLAG_FIXED) != 0; }
+    // Probed gates are the outputs being watched. With no probes at all,
+    // every gate counts as watched.
+    void SetProbed(GateId gate, bool probed);
+    bool IsProbed(GateId gate) const { return (gateFlags[gate] & FLAG_PROBED) != 0; }
+    size_t GetProbeCount() const { return probeCount; }
+    // Raw 0/1 input value per gate slot
+    const uint8_t* GetInputValueData() const { return inputValues.data(); }
+
+    // Delays are at least one time unit, so timed loops always make progress
+    void SetGateDelay(GateId gate, uint32_t delay);
+    uint32_t GetGateDelay(GateId gate) const { return gateDelays[gate]; }
+
+    GateKind GetKind(GateId gate) const { return gateKinds[gate]; }
+    std::span<const NetId> GetFanin(GateId gate) const { return { fanin.data() + faninBegin[gate], faninCount[gate] }; }
+    // Packed fanin of every gate; a gate's pins stay at GetFaninBegin for the life of its slot
+    const NetId* GetFaninData() const { return fanin.data(); }
+    uint32_t GetFaninBegin(GateId gate) const { return faninBegin[gate]; }
+    NetId GetOutput(GateId gate) const { return gate + CONST1 + 1; }
+    FanoutRange GetFanout(NetId net) const { return FanoutRange(this, firstReaderPin[net]); }
+    // Gate driving a net, or INVALID_GATE for the constant nets
+    GateId GetDriver(NetId net) const { return net > CONST1 ? net - (CONST1 + 1) : INVALID_GATE; }
+    bool IsValidGate(GateId gate) const { return gate < gateKinds.size() && gateKinds[gate] != GateKind::NONE; }
+
+    // Slot counts; removed gates stay as GateKind::NONE until reused
+    size_t GetGateCount() const { return gateKinds.size(); }
+    size_t GetNetCount() const { return netValues.size(); }
+    size_t GetLiveGateCount() const { return gateKinds.size() - freeGateCount; }
+    size_t GetPinCount() const { return fanin.size(); }
+
+    bool GetNetValue(NetId net) const { return netValues[net] != 0; }
+    void SetNetValue(NetId net, bool value) { netValues[net] = value ? 1 : 0; }
+    // Raw 0/1 value per net for engine inner loops
+    uint8_t* GetValueData() { return netValues.data(); }
+    const uint8_t* GetValueData() const { return netValues.data(); }
+
+    // Computes a gate's output from the current values of its input nets
+    bool Evaluate(GateId gate) const;
+
+    // Bumped on every structural edit so engines can invalidate cached schedules
+    uint64_t GetTopologyVersion() const { return topologyVersion; }
+
+    // Appends the gates added, removed or rewired in topology versions after
+    // `version`, so schedules can be patched instead of rebuilt. Returns
+    // false when the journal no longer reaches back that far.
+    bool GetEditsSince(uint64_t version, std::vector<GateId>& gates) const;
+
+    // Gates whose inputs or driven value changed outside of an engine step
+    const std::vector<GateId>& GetDirtyGates() const { return dirtyGates; }
+    void ClearDirtyGates() { dirtyGates.clear(); }
+
+private:
+    static constexpr uint32_t NO_PIN = UINT32_MAX;
+    static constexpr uint8_t FLAG_FIXED = 1;
+    static constexpr uint8_t FLAG_PROBED = 2;
+    // Journal entries kept beyond one per gate slot before it is dropped
+    static constexpr size_t JOURNAL_SLACK = 4096;
+
+    struct JournalEntry {
+        uint64_t version;
+        GateId gate;
+    };
+
+    struct SubcircuitInstance {
+        std::shared_ptr<const SubcircuitDefinition> definition;
+        std::vector<GateId> ports;
+    };
+
+    void RemoveSlot(GateId gate);
+    void ConnectPin(GateId gate, int pin, NetId net);
+    void MarkDirty(GateId gate);
+    void Journal(GateId gate);
+    void LinkReader(NetId net, uint32_t pin);
+    void UnlinkReader(NetId net, uint32_t pin);
+
+    // Per gate
+    std::vector<GateKind> gateKinds;
+    std::vector<uint32_t> faninBegin;
+    std::vector<uint32_t> faninCount;
+    std::vector<uint8_t> inputValues;
+    std::vector<uint32_t> gateDelays;
+    std::vector<uint8_t> gateFlags;
+    std::vector<SubcircuitId> gateSubcircuits;
+    std::vector<uint32_t> subcircuitPorts;
+
+    // Per input pin, grouped by gate
+    std::vector<NetId> fanin;
+    std::vector<GateId> pinGates;
+    std::vector<uint32_t> nextReaderPin;
+
+    // Per net
+    std::vector<uint8_t> netValues;
+    std::vector<uint32_t> firstReaderPin;
+
+    // Removed gate slots by input count, so a reused slot keeps its fanin range
+    std::vector<std::vector<GateId>> freeGates;
+    size_t freeGateCount = 0;
+    size_t probeCount = 0;
+
+    std::vector<SubcircuitInstance> subcircuits;
+    std::vector<SubcircuitId> freeSubcircuits;
+
+    std::vector<GateId> dirtyGates;
+    uint64_t topologyVersion = 0;
+    std::vector<JournalEntry> editJournal;
+    uint64_t journalBaseVersion = 0;
+
+    friend class FanoutRange;
+    friend class FanoutRange::Iterator;
+};
+
+inline GateId FanoutRange::Iterator::operator*() const {
+    return netlist->pinGates[pin];
+}
+
+inline FanoutRange::Iterator& FanoutRange::Iterator::operator++() {
+    pin = netlist->nextReaderPin[pin];
+    return *this;
+}
+
+inline FanoutRange::Iterator FanoutRange::end() const {
+    return Iterator(netlist, Netlist::NO_PIN);
+}
+
+inline bool FanoutRange::empty() const {
+    return firstPin == Netlist::NO_PIN;
+}
+
+#endif // NETLIST_H
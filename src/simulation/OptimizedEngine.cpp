@@ -0,0 +1,44 @@
+#include "OptimizedEngine.h"
+
+void OptimizedEngine::Step(Netlist& netlist) {
+    if (optimizedVersion != netlist.GetTopologyVersion()) {
+        optimized = OptimizeNetlist(netlist);
+        engine = LevelizedEngine();
+        optimizedVersion = netlist.GetTopologyVersion();
+
+        // The copy starts from the current values, so loops it keeps hold
+        // their state across edits and engine switches
+        uint8_t* seeded = optimized.netlist.GetValueData();
+        for (NetId net = Netlist::CONST1 + 1; net < optimized.netMap.size(); ++net) {
+            NetId mapped = optimized.netMap[net];
+            if (mapped != DEAD_NET && mapped > Netlist::CONST1) {
+                seeded[mapped] = netlist.GetNetValue(net);
+            }
+        }
+    }
+
+    // Values reset or restored outside the engine carry over to the copy
+    Netlist& inner = optimized.netlist;
+    uint8_t* innerValues = inner.GetValueData();
+    for (GateId gate : netlist.GetDirtyGates()) {
+        if (!netlist.IsValidGate(gate)) continue;
+        NetId net = netlist.GetOutput(gate);
+        NetId mapped = optimized.netMap[net];
+        if (mapped != DEAD_NET && mapped > Netlist::CONST1) {
+            innerValues[mapped] = netlist.GetNetValue(net);
+        }
+    }
+    for (const auto& [source, target] : optimized.inputs) {
+        inner.SetInputValue(target, netlist.GetInputValue(source));
+    }
+    engine.Step(inner);
+    netlist.ClearDirtyGates();
+
+    uint8_t* values = netlist.GetValueData();
+    for (NetId net = Netlist::CONST1 + 1; net < optimized.netMap.size(); ++net) {
+        NetId mapped = optimized.netMap[net];
+        if (mapped != DEAD_NET) {
+            values[net] = innerValues[mapped];
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef OPTIMIZED_ENGINE_H
+#define OPTIMIZED_ENGINE_H
+
+#include "Engine.h"
+#include "LevelizedEngine.h"
+#include "Optimizer.h"
+#include <cstdint>
+
+// Simulates an optimized copy of the netlist with the levelized engine and
+// copies the results back, so callers see every net of the original except
+// those no probed gate depends on, which keep their last value. The copy
+// is rebuilt after every structural edit.
+class OptimizedEngine : public Engine {
+public:
+    const char* GetName() const override { return "Optimized"; }
+    void Step(Netlist& netlist) override;
+
+    const OptimizedNetlist& GetOptimized() const { return optimized; }
+
+private:
+    OptimizedNetlist optimized;
+    LevelizedEngine engine;
+    uint64_t optimizedVersion = UINT64_MAX;
+};
+
+#endif // OPTIMIZED_ENGINE_H
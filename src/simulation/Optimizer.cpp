@@ -0,0 +1,210 @@
+#include "Optimizer.h"
+#include "Levelizer.h"
+#include "Subcircuit.h"
+#include <algorithm>
+
+namespace {
+
+struct Rewriter {
+    const Netlist& netlist;
+    // Per gate: the net now carrying its value, and the simplified inputs of
+    // gates that stay
+    std::vector<NetId> replacements;
+    std::vector<std::vector<NetId>> inputs;
+
+    explicit Rewriter(const Netlist& netlist)
+        : netlist(netlist), replacements(netlist.GetGateCount()), inputs(netlist.GetGateCount()) {
+        for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+            replacements[gate] = netlist.GetOutput(gate);
+        }
+    }
+
+    NetId Resolve(NetId net) const {
+        GateId driver = netlist.GetDriver(net);
+        return driver == INVALID_GATE ? net : replacements[driver];
+    }
+
+    bool IsKept(GateId gate) const {
+        return netlist.IsValidGate(gate) && replacements[gate] == netlist.GetOutput(gate);
+    }
+
+    // Simplified inputs of a kept gate, resolved through replacements
+    void Collect(GateId gate) {
+        std::vector<NetId>& resolved = inputs[gate];
+        resolved.clear();
+        for (NetId net : netlist.GetFanin(gate)) {
+            resolved.push_back(Resolve(net));
+        }
+    }
+
+    // Returns the replacement net of an acyclic gate
+    NetId Simplify(GateId gate) {
+        Collect(gate);
+        std::vector<NetId>& resolved = inputs[gate];
+        const NetId output = netlist.GetOutput(gate);
+
+        switch (netlist.GetKind(gate)) {
+            case GateKind::INPUT:
+                if (netlist.IsInputFixed(gate)) {
+                    return netlist.GetInputValue(gate) ? Netlist::CONST1 : Netlist::CONST0;
+                }
+                return output;
+
+            case GateKind::AND:
+            case GateKind::OR: {
+                if (resolved.empty()) return Netlist::CONST0;
+                const bool isAnd = netlist.GetKind(gate) == GateKind::AND;
+                const NetId dominant = isAnd ? Netlist::CONST0 : Netlist::CONST1;
+                const NetId neutral = isAnd ? Netlist::CONST1 : Netlist::CONST0;
+                if (std::find(resolved.begin(), resolved.end(), dominant) != resolved.end()) return dominant;
+
+                resolved.erase(std::remove(resolved.begin(), resolved.end(), neutral), resolved.end());
+                std::sort(resolved.begin(), resolved.end());
+                resolved.erase(std::unique(resolved.begin(), resolved.end()), resolved.end());
+                if (resolved.empty()) return neutral;
+                if (resolved.size() == 1) return resolved[0];
+                return output;
+            }
+
+            case GateKind::XOR: {
+                // Equal inputs cancel in pairs, so at most one CONST1 is left
+                resolved.erase(std::remove(resolved.begin(), resolved.end(), Netlist::CONST0), resolved.end());
+                std::sort(resolved.begin(), resolved.end());
+                size_t kept = 0;
+                for (size_t i = 0; i < resolved.size(); ++i) {
+                    if (i + 1 < resolved.size() && resolved[i] == resolved[i + 1]) {
+                        ++i;
+                    } else {
+                        resolved[kept++] = resolved[i];
+                    }
+                }
+                resolved.resize(kept);
+                if (resolved.empty()) return Netlist::CONST0;
+                if (resolved.size() == 1) return resolved[0];
+                return output;
+            }
+
+            case GateKind::NOT: {
+                NetId input = resolved[0];
+                if (input == Netlist::CONST0) return Netlist::CONST1;
+                if (input == Netlist::CONST1) return Netlist::CONST0;
+                GateId driver = netlist.GetDriver(input);
+                if (netlist.GetKind(driver) == GateKind::NOT) return inputs[driver][0];
+                return output;
+            }
+
+            case GateKind::SUBCIRCUIT:
+            case GateKind::NONE:
+                break;
+        }
+        return output;
+    }
+};
+
+} // namespace
+
+OptimizedNetlist OptimizeNetlist(const Netlist& netlist) {
+    OptimizedNetlist result;
+    Rewriter rewriter(netlist);
+
+    // Constant propagation and collapsing, inputs before readers
+    Levelization levels = Levelize(netlist);
+    for (GateId gate : levels.order) {
+        NetId replacement = rewriter.Simplify(gate);
+        rewriter.replacements[gate] = replacement;
+        if (replacement <= Netlist::CONST1) {
+            ++result.foldedGates;
+        } else if (replacement != netlist.GetOutput(gate)) {
+            ++result.collapsedGates;
+        }
+    }
+    for (GateId gate : levels.cyclicGates) {
+        rewriter.Collect(gate);
+    }
+
+    // Keep what the probed gates (or, without probes, any gate) depend on
+    const size_t gateCount = netlist.GetGateCount();
+    const bool allWatched = netlist.GetProbeCount() == 0;
+    std::vector<uint8_t> live(gateCount, 0);
+    std::vector<GateId> work;
+    auto markNet = [&](NetId net) {
+        GateId driver = netlist.GetDriver(net);
+        if (driver != INVALID_GATE && !live[driver]) {
+            live[driver] = 1;
+            work.push_back(driver);
+        }
+    };
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (netlist.IsValidGate(gate) && (allWatched || netlist.IsProbed(gate))) {
+            markNet(rewriter.replacements[gate]);
+        }
+    }
+    while (!work.empty()) {
+        GateId gate = work.back();
+        work.pop_back();
+        for (NetId net : rewriter.inputs[gate]) {
+            markNet(net);
+        }
+        // Instances are kept or dropped whole
+        SubcircuitId instance = netlist.GetSubcircuitOf(gate);
+        if (instance != INVALID_SUBCIRCUIT) {
+            for (GateId port : netlist.GetSubcircuitPorts(instance)) {
+                markNet(netlist.GetOutput(port));
+            }
+        }
+    }
+
+    // Emit surviving gates in slot order, then wire them up
+    std::vector<GateId> newGates(gateCount, INVALID_GATE);
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (!rewriter.IsKept(gate)) continue;
+        if (!live[gate]) {
+            ++result.deadGates;
+            continue;
+        }
+        if (newGates[gate] != INVALID_GATE) continue;
+        SubcircuitId instance = netlist.GetSubcircuitOf(gate);
+        if (instance != INVALID_SUBCIRCUIT) {
+            // Subcircuits stay opaque; the copy wires up its own state pins
+            SubcircuitId copy = result.netlist.AddSubcircuit(netlist.GetSharedSubcircuitDefinition(instance));
+            std::span<const GateId> ports = netlist.GetSubcircuitPorts(instance);
+            for (size_t port = 0; port < ports.size(); ++port) {
+                newGates[ports[port]] = result.netlist.GetSubcircuitPorts(copy)[port];
+            }
+            continue;
+        }
+        int arity = static_cast<int>(rewriter.inputs[gate].size());
+        newGates[gate] = result.netlist.AddGate(netlist.GetKind(gate), arity);
+        if (netlist.GetKind(gate) == GateKind::INPUT) {
+            result.netlist.SetInputValue(newGates[gate], netlist.GetInputValue(gate));
+            result.inputs.push_back({ gate, newGates[gate] });
+        }
+    }
+
+    auto mapNet = [&](NetId net) -> NetId {
+        if (net <= Netlist::CONST1) return net;
+        GateId gate = newGates[netlist.GetDriver(net)];
+        return gate == INVALID_GATE ? DEAD_NET : result.netlist.GetOutput(gate);
+    };
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (newGates[gate] == INVALID_GATE) continue;
+        const std::vector<NetId>& resolved = rewriter.inputs[gate];
+        size_t pinCount = resolved.size();
+        if (netlist.GetKind(gate) == GateKind::SUBCIRCUIT) {
+            pinCount = netlist.GetSubcircuitDefinition(netlist.GetSubcircuitOf(gate)).GetInputCount();
+        }
+        for (size_t pin = 0; pin < pinCount; ++pin) {
+            result.netlist.ConnectInput(newGates[gate], static_cast<int>(pin), mapNet(resolved[pin]));
+        }
+    }
+
+    result.netMap.assign(netlist.GetNetCount(), DEAD_NET);
+    result.netMap[Netlist::CONST0] = Netlist::CONST0;
+    result.netMap[Netlist::CONST1] = Netlist::CONST1;
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (netlist.IsValidGate(gate)) {
+            result.netMap[netlist.GetOutput(gate)] = mapNet(rewriter.replacements[gate]);
+        }
+    }
+    return result;
+}
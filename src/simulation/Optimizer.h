@@ -0,0 +1,35 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <vector>
+
+constexpr NetId DEAD_NET = UINT32_MAX;
+
+// A smaller netlist that computes the same watched values as its source,
+// plus how to read the source's nets back out of it
+struct OptimizedNetlist {
+    Netlist netlist;
+    // Source net -> optimized net (possibly a constant), or DEAD_NET when
+    // the net can no longer affect any probed gate
+    std::vector<NetId> netMap;
+    // Source INPUT gate and the optimized INPUT gate it drives
+    std::vector<std::pair<GateId, GateId>> inputs;
+
+    size_t foldedGates = 0;        // replaced by a constant
+    size_t collapsedGates = 0;     // double inversions and single-input gates
+    size_t deadGates = 0;          // unable to reach a probed gate
+};
+
+// Runs the optimization passes over a netlist:
+//  - constant propagation, treating fixed inputs as constants and
+//    simplifying AND/OR gates with constant or repeated inputs
+//  - NOT(NOT(x)) and single-input AND/OR collapse to x
+//  - removal of logic no probed gate depends on
+// Gates in or after combinational loops are kept as they are, apart from
+// reading simplified nets. Subcircuit instances are kept or dropped whole and
+// never looked into.
+OptimizedNetlist OptimizeNetlist(const Netlist& netlist);
+
+#endif // OPTIMIZER_H
@@ -0,0 +1,76 @@
+#include "SccEngine.h"
+#include "StronglyConnected.h"
+#include <algorithm>
+
+void SccEngine::Step(Netlist& netlist) {
+    if (compiledVersion != netlist.GetTopologyVersion()) {
+        Compile(netlist);
+    }
+
+    uint8_t* values = netlist.GetValueData();
+    oscillatingComponentCount = 0;
+    for (const Block& block : blocks) {
+        if (!block.cyclic) {
+            EvaluateCompiledGates(netlist, values, fanin.data(), gates.data() + block.begin, gates.data() + block.end);
+        } else if (!SettleLoop(netlist, values, block)) {
+            ++oscillatingComponentCount;
+        }
+    }
+    netlist.ClearDirtyGates();
+}
+
+void SccEngine::Compile(const Netlist& netlist) {
+    SccDecomposition components = FindStronglyConnectedComponents(netlist);
+
+    gates.clear();
+    fanin.clear();
+    blocks.clear();
+    cyclicComponentCount = 0;
+    for (size_t component = 0; component < components.GetComponentCount(); ++component) {
+        uint32_t begin = static_cast<uint32_t>(gates.size());
+        for (uint32_t i = components.componentOffsets[component]; i < components.componentOffsets[component + 1]; ++i) {
+            GateId gate = components.gates[i];
+            std::span<const NetId> inputs = netlist.GetFanin(gate);
+            gates.push_back({
+                netlist.GetKind(gate),
+                static_cast<uint32_t>(fanin.size()),
+                static_cast<uint32_t>(inputs.size()),
+                netlist.GetOutput(gate),
+                gate
+            });
+            fanin.insert(fanin.end(), inputs.begin(), inputs.end());
+        }
+        uint32_t end = static_cast<uint32_t>(gates.size());
+
+        bool cyclic = components.componentCyclic[component] != 0;
+        if (cyclic) {
+            ++cyclicComponentCount;
+        }
+        // Neighbouring acyclic gates share one straight-line block
+        if (!cyclic && !blocks.empty() && !blocks.back().cyclic) {
+            blocks.back().end = end;
+        } else {
+            blocks.push_back({ begin, end, cyclic });
+        }
+    }
+    compiledVersion = netlist.GetTopologyVersion();
+}
+
+bool SccEngine::SettleLoop(const Netlist& netlist, uint8_t* values, const Block& block) {
+    // Sweeps are deterministic, so a repeated loop state means it will never settle
+    stateHashes.clear();
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        bool changed = false;
+        uint64_t hash = 14695981039346656037ull;
+        for (const CompiledGate* op = gates.data() + block.begin; op != gates.data() + block.end; ++op) {
+            uint8_t previous = values[op->output];
+            EvaluateCompiledGates(netlist, values, fanin.data(), op, op + 1);
+            changed = changed || values[op->output] != previous;
+            hash = (hash ^ values[op->output]) * 1099511628211ull;
+        }
+        if (!changed) return true;
+        if (std::find(stateHashes.begin(), stateHashes.end(), hash) != stateHashes.end()) return false;
+        stateHashes.push_back(hash);
+    }
+    return false;
+}
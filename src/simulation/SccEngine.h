@@ -0,0 +1,50 @@
+#ifndef SCC_ENGINE_H
+#define SCC_ENGINE_H
+
+#include "Engine.h"
+#include "CompiledNetlist.h"
+#include <cstdint>
+#include <vector>
+
+// Compiled-code simulation that understands feedback. The gate graph is
+// split into strongly connected components: acyclic gates run once in
+// levelized order, and each loop (a latch, a ring oscillator) is swept
+// repeatedly, seeing its own updates as it goes, until it stops changing.
+// A loop that returns to an earlier state, or hits the iteration bound, is
+// counted as oscillating and left where it is until the next step.
+class SccEngine : public Engine {
+public:
+    static const int DEFAULT_MAX_ITERATIONS = 64;
+
+    const char* GetName() const override { return "SCC"; }
+    void Step(Netlist& netlist) override;
+
+    void SetMaxIterations(int iterations) { maxIterations = iterations; }
+    int GetMaxIterations() const { return maxIterations; }
+
+    size_t GetCyclicComponentCount() const { return cyclicComponentCount; }
+    // Loops that did not settle during the last step
+    size_t GetOscillatingComponentCount() const { return oscillatingComponentCount; }
+
+private:
+    // Gates [begin, end): a straight run of acyclic gates or one loop
+    struct Block {
+        uint32_t begin;
+        uint32_t end;
+        bool cyclic;
+    };
+
+    void Compile(const Netlist& netlist);
+    bool SettleLoop(const Netlist& netlist, uint8_t* values, const Block& block);
+
+    std::vector<CompiledGate> gates;
+    std::vector<NetId> fanin;
+    std::vector<Block> blocks;
+    std::vector<uint64_t> stateHashes;
+    uint64_t compiledVersion = UINT64_MAX;
+    size_t cyclicComponentCount = 0;
+    size_t oscillatingComponentCount = 0;
+    int maxIterations = DEFAULT_MAX_ITERATIONS;
+};
+
+#endif // SCC_ENGINE_H
@@ -0,0 +1,195 @@
+#include "SimulationHistory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+void WriteVarint(std::vector<uint8_t>& data, uint32_t value) {
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t ReadVarint(const uint8_t*& in) {
+    uint32_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t byte = *in++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) return value;
+    }
+}
+
+// Toggles the nets listed in one delta
+const uint8_t* ApplyDelta(const uint8_t* in, std::vector<uint8_t>& values) {
+    uint32_t count = ReadVarint(in);
+    NetId net = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        net += ReadVarint(in);
+        values[net] ^= 1;
+    }
+    return in;
+}
+
+} // namespace
+
+void SimulationHistory::SetMemoryLimit(size_t bytes) {
+    memoryLimit = bytes;
+    while (memoryUsage > memoryLimit && segments.size() > 1) {
+        EvictOldest();
+    }
+}
+
+void SimulationHistory::SetSnapshotInterval(uint32_t ticks) {
+    snapshotInterval = std::max<uint32_t>(ticks, 1);
+}
+
+void SimulationHistory::Clear() {
+    segments.clear();
+    shadow.clear();
+    lastTick = 0;
+    topologyVersion = UINT64_MAX;
+    memoryUsage = 0;
+}
+
+void SimulationHistory::Record(const Netlist& netlist, uint64_t tick, const std::vector<NetId>* changedNets) {
+    if (netlist.GetTopologyVersion() != topologyVersion) {
+        Clear();
+        topologyVersion = netlist.GetTopologyVersion();
+    }
+    if (!segments.empty() && tick <= lastTick) {
+        Truncate(tick);
+    }
+    if (segments.empty() || tick != lastTick + 1 || tick - segments.back().firstTick >= snapshotInterval) {
+        StartSegment(netlist, tick);
+    } else {
+        // Changed nets come out in ascending order, so gaps stay small
+        Segment& segment = segments.back();
+        UpdateMemoryUsage(segment, -1);
+        segment.deltaOffsets.push_back(static_cast<uint32_t>(segment.data.size()));
+        const uint8_t* values = netlist.GetValueData();
+        changed.clear();
+        if (changedNets) {
+            // A net written twice, or back to its old value, matches the
+            // shadow by the time it is checked again
+            for (NetId net : *changedNets) {
+                if (values[net] != shadow[net]) {
+                    changed.push_back(net);
+                    shadow[net] = values[net];
+                }
+            }
+            std::sort(changed.begin(), changed.end());
+        } else {
+            DiffAgainstShadow(values);
+        }
+        WriteVarint(segment.data, static_cast<uint32_t>(changed.size()));
+        NetId previous = 0;
+        for (NetId changedNet : changed) {
+            WriteVarint(segment.data, changedNet - previous);
+            previous = changedNet;
+        }
+        UpdateMemoryUsage(segment, 1);
+    }
+    lastTick = tick;
+
+    while (memoryUsage > memoryLimit && segments.size() > 1) {
+        EvictOldest();
+    }
+}
+
+void SimulationHistory::DiffAgainstShadow(const uint8_t* values) {
+    const size_t netCount = shadow.size();
+    NetId net = 0;
+    // Most nets hold still from tick to tick, so compare eight at a time
+    for (; net + 8 <= netCount; net += 8) {
+        uint64_t current, previous;
+        std::memcpy(&current, values + net, 8);
+        std::memcpy(&previous, shadow.data() + net, 8);
+        if (current == previous) continue;
+        for (NetId i = net; i < net + 8; ++i) {
+            if (values[i] != shadow[i]) changed.push_back(i);
+        }
+        std::memcpy(shadow.data() + net, &current, 8);
+    }
+    for (; net < netCount; ++net) {
+        if (values[net] != shadow[net]) {
+            changed.push_back(net);
+            shadow[net] = values[net];
+        }
+    }
+}
+
+bool SimulationHistory::Seek(Netlist& netlist, uint64_t tick) {
+    if (segments.empty() || netlist.GetTopologyVersion() != topologyVersion) return false;
+    if (tick < GetFirstTick() || tick > lastTick) return false;
+
+    auto segment = std::upper_bound(segments.begin(), segments.end(), tick,
+                                    [](uint64_t t, const Segment& s) { return t < s.firstTick; }) - 1;
+    // Ticks skipped between recordings are not held
+    if (tick - segment->firstTick > segment->deltaOffsets.size()) return false;
+
+    std::vector<uint8_t> values(shadow.size());
+    for (size_t net = 0; net < values.size(); ++net) {
+        values[net] = (segment->data[net / 8] >> (net % 8)) & 1;
+    }
+    const uint8_t* in = segment->data.data() + (values.size() + 7) / 8;
+    for (uint64_t t = segment->firstTick; t < tick; ++t) {
+        in = ApplyDelta(in, values);
+    }
+
+    netlist.LoadValues(values.data());
+    shadow = std::move(values);
+    return true;
+}
+
+void SimulationHistory::StartSegment(const Netlist& netlist, uint64_t tick) {
+    const uint8_t* values = netlist.GetValueData();
+    shadow.assign(values, values + netlist.GetNetCount());
+
+    Segment& segment = segments.emplace_back();
+    segment.firstTick = tick;
+    segment.data.assign((shadow.size() + 7) / 8, 0);
+    for (size_t net = 0; net < shadow.size(); ++net) {
+        segment.data[net / 8] |= static_cast<uint8_t>(shadow[net] << (net % 8));
+    }
+    UpdateMemoryUsage(segment, 1);
+}
+
+void SimulationHistory::Truncate(uint64_t tick) {
+    while (!segments.empty() && segments.back().firstTick >= tick) {
+        UpdateMemoryUsage(segments.back(), -1);
+        segments.pop_back();
+    }
+    if (segments.empty()) return;
+
+    // Keep the deltas up to tick - 1 and bring the shadow to that tick
+    Segment& segment = segments.back();
+    UpdateMemoryUsage(segment, -1);
+    size_t kept = tick - 1 - segment.firstTick;
+    if (kept < segment.deltaOffsets.size()) {
+        segment.data.resize(segment.deltaOffsets[kept]);
+        segment.deltaOffsets.resize(kept);
+    }
+    UpdateMemoryUsage(segment, 1);
+
+    shadow.assign(shadow.size(), 0);
+    for (size_t net = 0; net < shadow.size(); ++net) {
+        shadow[net] = (segment.data[net / 8] >> (net % 8)) & 1;
+    }
+    const uint8_t* in = segment.data.data() + (shadow.size() + 7) / 8;
+    for (size_t i = 0; i < segment.deltaOffsets.size(); ++i) {
+        in = ApplyDelta(in, shadow);
+    }
+    lastTick = tick - 1;
+}
+
+void SimulationHistory::EvictOldest() {
+    UpdateMemoryUsage(segments.front(), -1);
+    segments.pop_front();
+}
+
+void SimulationHistory::UpdateMemoryUsage(const Segment& segment, ptrdiff_t sign) {
+    size_t bytes = segment.data.size() + segment.deltaOffsets.size() * sizeof(uint32_t);
+    memoryUsage = sign > 0 ? memoryUsage + bytes : memoryUsage - bytes;
+}
@@ -0,0 +1,74 @@
+#ifndef SIMULATION_HISTORY_H
+#define SIMULATION_HISTORY_H
+
+#include "Netlist.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Recent net values, tick by tick, for stepping backwards and seeking.
+// Each recorded tick stores only the nets that changed since the previous
+// tick, kept in a shadow copy, as varint-coded gaps between net ids. Every snapshot interval a full bit-packed snapshot starts a new
+// segment, so a seek restores one snapshot and replays at most an
+// interval's worth of deltas. When the memory limit is exceeded the oldest
+// segment is dropped.
+//
+// When the engine reports the nets its step wrote, only those are checked,
+// so recording costs in proportion to activity. Otherwise every net is
+// compared against the shadow, eight at a time; such engines rewrite every
+// net each step anyway.
+// Structural edits change the set of nets, so they clear the history.
+class SimulationHistory {
+public:
+    static constexpr size_t DEFAULT_MEMORY_LIMIT = 64 << 20;
+    static constexpr uint32_t DEFAULT_SNAPSHOT_INTERVAL = 1024;
+
+    void SetMemoryLimit(size_t bytes);
+    size_t GetMemoryLimit() const { return memoryLimit; }
+    void SetSnapshotInterval(uint32_t ticks);
+    uint32_t GetSnapshotInterval() const { return snapshotInterval; }
+
+    // Adds the netlist's values as of `tick`. changedNets, when given, lists
+    // every net whose value may differ from the previous tick (see
+    // Engine::GetChangedNets). Recording a tick at or before the last one
+    // first drops everything from that tick on.
+    void Record(const Netlist& netlist, uint64_t tick, const std::vector<NetId>* changedNets = nullptr);
+
+    // Loads the values recorded for `tick` into the netlist, keeping later
+    // ticks until something new is recorded. Returns false when the tick is
+    // not held or the netlist has been edited since.
+    bool Seek(Netlist& netlist, uint64_t tick);
+
+    void Clear();
+    bool IsEmpty() const { return segments.empty(); }
+    uint64_t GetFirstTick() const { return segments.empty() ? 0 : segments.front().firstTick; }
+    uint64_t GetLastTick() const { return lastTick; }
+    size_t GetMemoryUsage() const { return memoryUsage; }
+
+private:
+    // A snapshot followed by the deltas of the ticks after it
+    struct Segment {
+        uint64_t firstTick;
+        std::vector<uint8_t> data;
+        std::vector<uint32_t> deltaOffsets;  // start of the delta of firstTick + 1 + i
+    };
+
+    void StartSegment(const Netlist& netlist, uint64_t tick);
+    // Appends every net that differs from the shadow and updates the shadow
+    void DiffAgainstShadow(const uint8_t* values);
+    void Truncate(uint64_t tick);
+    void EvictOldest();
+    void UpdateMemoryUsage(const Segment& segment, ptrdiff_t sign);
+
+    std::deque<Segment> segments;
+    std::vector<uint8_t> shadow;
+    std::vector<NetId> changed;  // reused by every Record
+    uint64_t lastTick = 0;
+    uint64_t topologyVersion = UINT64_MAX;
+    size_t memoryLimit = DEFAULT_MEMORY_LIMIT;
+    uint32_t snapshotInterval = DEFAULT_SNAPSHOT_INTERVAL;
+    size_t memoryUsage = 0;
+};
+
+#endif // SIMULATION_HISTORY_H
@@ -0,0 +1,118 @@
+#include "SimulationThread.h"
+#include "Simulator.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Seconds = std::chrono::duration<double>;
+
+// Longest stretch the thread holds the lock when running unlimited
+constexpr Seconds UNLIMITED_SLICE{0.002};
+// Backlog beyond this is dropped rather than replayed in a burst
+constexpr Seconds MAX_BACKLOG{0.1};
+// Upper bound on a single sleep so Stop() and rate changes are noticed quickly
+constexpr Seconds MAX_SLEEP{0.01};
+constexpr Seconds RATE_WINDOW{0.5};
+
+} // namespace
+
+SimulationThread::SimulationThread(Simulator& simulator) : simulator(simulator) {}
+
+SimulationThread::~SimulationThread() {
+    Stop();
+}
+
+void SimulationThread::Start() {
+    if (IsRunning()) return;
+    running = true;
+    thread = std::thread(&SimulationThread::Run, this);
+}
+
+void SimulationThread::Stop() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+    achievedTickRate = 0.0;
+}
+
+void SimulationThread::SetTickRate(double ticksPerSecond) {
+    tickRate = std::max(ticksPerSecond, 0.0);
+    rateChanged = true;
+}
+
+std::unique_lock<std::mutex> SimulationThread::Lock() {
+    ++waiters;
+    std::unique_lock<std::mutex> lock(mutex);
+    --waiters;
+    return lock;
+}
+
+void SimulationThread::Run() {
+    Clock::time_point nextTick = Clock::now();
+    Clock::time_point windowStart = nextTick;
+    uint64_t windowTicks = 0;
+
+    while (running) {
+        Clock::time_point now = Clock::now();
+        if (now - windowStart >= RATE_WINDOW) {
+            achievedTickRate = windowTicks / Seconds(now - windowStart).count();
+            windowStart = now;
+            windowTicks = 0;
+        }
+
+        if (paused) {
+            std::this_thread::sleep_for(MAX_SLEEP);
+            nextTick = Clock::now();
+            continue;
+        }
+
+        double rate = tickRate;
+        if (rateChanged.exchange(false)) {
+            nextTick = now;
+        }
+
+        if (rate <= UNLIMITED) {
+            // Step in short slices so other threads can take the lock in between
+            std::unique_lock<std::mutex> lock(mutex);
+            Clock::time_point sliceEnd = Clock::now() + std::chrono::duration_cast<Clock::duration>(UNLIMITED_SLICE);
+            do {
+                for (int i = 0; i < 64; ++i) {
+                    simulator.Step();
+                }
+                windowTicks += 64;
+            } while (Clock::now() < sliceEnd && waiters == 0);
+        } else {
+            if (now < nextTick) {
+                std::this_thread::sleep_until(std::min(nextTick, now + std::chrono::duration_cast<Clock::duration>(MAX_SLEEP)));
+                continue;
+            }
+
+            Seconds period(1.0 / rate);
+            Seconds behind = now - nextTick;
+            if (behind > MAX_BACKLOG) {
+                nextTick = now;
+                behind = Seconds(0);
+            }
+            uint64_t due = 1 + static_cast<uint64_t>(behind / period);
+            nextTick += std::chrono::duration_cast<Clock::duration>(period * static_cast<double>(due));
+
+            std::unique_lock<std::mutex> lock(mutex);
+            for (uint64_t i = 0; i < due; ++i) {
+                simulator.Step();
+                ++windowTicks;
+                if (waiters > 0 && i + 1 < due) {
+                    // Hand the lock over now and catch up on the next pass
+                    nextTick -= std::chrono::duration_cast<Clock::duration>(period * static_cast<double>(due - i - 1));
+                    break;
+                }
+            }
+        }
+
+        while (waiters > 0) {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+class Simulator;
+
+// Steps a Simulator on its own thread at a fixed tick rate, independent of
+// the render frame rate. A rate of 0 runs as fast as possible.
+//
+// The thread holds the lock returned by Lock() while stepping. Anything that
+// edits or reads the simulator from another thread must hold it too; a
+// pending Lock() makes the thread back off between batches of ticks.
+class SimulationThread {
+public:
+    static constexpr double UNLIMITED = 0.0;
+
+    explicit SimulationThread(Simulator& simulator);
+    ~SimulationThread();
+
+    void Start();
+    void Stop();
+    bool IsRunning() const { return thread.joinable(); }
+
+    void SetPaused(bool pause) { paused = pause; }
+    bool IsPaused() const { return paused; }
+
+    void SetTickRate(double ticksPerSecond);
+    double GetTickRate() const { return tickRate; }
+
+    // Ticks per second measured over the last half second
+    double GetAchievedTickRate() const { return achievedTickRate; }
+
+    std::unique_lock<std::mutex> Lock();
+
+private:
+    void Run();
+
+    Simulator& simulator;
+    std::thread thread;
+    std::mutex mutex;
+    std::atomic<bool> running{false};
+    std::atomic<bool> paused{false};
+    std::atomic<bool> rateChanged{false};
+    std::atomic<int> waiters{0};
+    std::atomic<double> tickRate{60.0};
+    std::atomic<double> achievedTickRate{0.0};
+};
+
+#endif // SIMULATION_THREAD_H
@@ -0,0 +1,110 @@
+#include "Simulator.h"
+#include "SweepEngine.h"
+#include "EventDrivenEngine.h"
+#include "LevelizedEngine.h"
+#include "BitParallelEngine.h"
+#include "IslandParallelEngine.h"
+#include "LevelParallelEngine.h"
+#include "BytecodeEngine.h"
+#include "NativeEngine.h"
+#include "SccEngine.h"
+#include "TimedEngine.h"
+#include "OptimizedEngine.h"
+#include "AigEngine.h"
+#include <algorithm>
+
+Simulator::Simulator() {
+    SetEngine(EngineKind::EVENT_DRIVEN);
+}
+
+void Simulator::SetEngine(EngineKind kind) {
+    switch (kind) {
+        case EngineKind::SWEEP:
+            engine = std::make_unique<SweepEngine>();
+            break;
+        case EngineKind::EVENT_DRIVEN:
+            engine = std::make_unique<EventDrivenEngine>();
+            break;
+        case EngineKind::LEVELIZED:
+            engine = std::make_unique<LevelizedEngine>();
+            break;
+        case EngineKind::BIT_PARALLEL:
+            engine = std::make_unique<BitParallelEngine>();
+            break;
+        case EngineKind::ISLAND_PARALLEL:
+            engine = std::make_unique<IslandParallelEngine>();
+            break;
+        case EngineKind::LEVEL_PARALLEL:
+            engine = std::make_unique<LevelParallelEngine>();
+            break;
+        case EngineKind::BYTECODE:
+            engine = std::make_unique<BytecodeEngine>();
+            break;
+        case EngineKind::NATIVE:
+            engine = std::make_unique<NativeEngine>();
+            break;
+        case EngineKind::SCC:
+            engine = std::make_unique<SccEngine>();
+            break;
+        case EngineKind::TIMED:
+            engine = std::make_unique<TimedEngine>();
+            break;
+        case EngineKind::OPTIMIZED:
+            engine = std::make_unique<OptimizedEngine>();
+            break;
+        case EngineKind::AIG:
+            engine = std::make_unique<AigEngine>();
+            break;
+    }
+    engineKind = kind;
+}
+
+void Simulator::Step() {
+    engine->Step(netlist);
+    ++tick;
+    if (historyEnabled) {
+        history.Record(netlist, tick, engine->GetChangedNets());
+    }
+    for (WaveformSink* sink : waveformSinks) {
+        sink->Capture(netlist, tick);
+    }
+}
+
+void Simulator::AddWaveformSink(WaveformSink* sink) {
+    if (std::find(waveformSinks.begin(), waveformSinks.end(), sink) == waveformSinks.end()) {
+        waveformSinks.push_back(sink);
+    }
+}
+
+void Simulator::RemoveWaveformSink(WaveformSink* sink) {
+    waveformSinks.erase(std::remove(waveformSinks.begin(), waveformSinks.end(), sink), waveformSinks.end());
+}
+
+void Simulator::Run(uint64_t steps) {
+    for (uint64_t i = 0; i < steps; ++i) {
+        Step();
+    }
+}
+
+void Simulator::Reset() {
+    netlist.ResetValues();
+    tick = 0;
+    history.Clear();
+    if (historyEnabled) {
+        history.Record(netlist, tick);
+    }
+}
+
+void Simulator::SetHistoryEnabled(bool enabled) {
+    historyEnabled = enabled;
+    history.Clear();
+    if (historyEnabled) {
+        history.Record(netlist, tick);
+    }
+}
+
+bool Simulator::Seek(uint64_t targetTick) {
+    if (!historyEnabled || !history.Seek(netlist, targetTick)) return false;
+    tick = targetTick;
+    return true;
+}
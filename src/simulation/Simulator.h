@@ -0,0 +1,68 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "Engine.h"
+#include "Netlist.h"
+#include "SimulationHistory.h"
+#include "WaveformSink.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum class EngineKind {
+    SWEEP,
+    EVENT_DRIVEN,
+    LEVELIZED,
+    BIT_PARALLEL,
+    ISLAND_PARALLEL,
+    LEVEL_PARALLEL,
+    BYTECODE,
+    NATIVE,
+    SCC,
+    TIMED,
+    OPTIMIZED,
+    AIG
+};
+
+// Owns a netlist and the engine that advances it. This is the entry point
+// for headless simulation; the GUI drives one through SimulationManager.
+class Simulator {
+public:
+    Simulator();
+
+    Netlist& GetNetlist() { return netlist; }
+    const Netlist& GetNetlist() const { return netlist; }
+
+    void SetEngine(EngineKind kind);
+    EngineKind GetEngineKind() const { return engineKind; }
+    const char* GetEngineName() const { return engine->GetName(); }
+
+    void Step();
+    void Run(uint64_t steps);
+    void Reset();
+
+    uint64_t GetTick() const { return tick; }
+
+    // While enabled every tick is recorded, so Seek can return to it
+    void SetHistoryEnabled(bool enabled);
+    bool IsHistoryEnabled() const { return historyEnabled; }
+    SimulationHistory& GetHistory() { return history; }
+    const SimulationHistory& GetHistory() const { return history; }
+    // Restores a recorded tick; stepping from there overwrites later ticks
+    bool Seek(uint64_t targetTick);
+
+    // Sinks see the values after every step, in the order they were added
+    void AddWaveformSink(WaveformSink* sink);
+    void RemoveWaveformSink(WaveformSink* sink);
+
+private:
+    Netlist netlist;
+    std::unique_ptr<Engine> engine;
+    EngineKind engineKind;
+    uint64_t tick = 0;
+    SimulationHistory history;
+    bool historyEnabled = false;
+    std::vector<WaveformSink*> waveformSinks;
+};
+
+#endif // SIMULATOR_H
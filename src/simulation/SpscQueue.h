@@ -0,0 +1,79 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+// Each side caches the other's index and only reloads it when the queue
+// looks full or empty, so the shared cache lines are rarely touched.
+template<typename T>
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t GetCapacity() const { return slots.size(); }
+
+    // Producer side. True when `count` more values fit.
+    bool HasSpace(size_t count) {
+        if (slots.size() - (producerTail - cachedHead) >= count) return true;
+        cachedHead = head.load(std::memory_order_acquire);
+        return slots.size() - (producerTail - cachedHead) >= count;
+    }
+
+    bool TryPush(const T& value) {
+        size_t tail = producerTail;
+        if (tail - cachedHead == slots.size()) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (tail - cachedHead == slots.size()) return false;
+        }
+        slots[tail & mask] = value;
+        producerTail = tail + 1;
+        return true;
+    }
+
+    // Makes pushed values visible to the consumer
+    void Publish() { tail.store(producerTail, std::memory_order_release); }
+
+    // Consumer side; returns the number of values copied
+    size_t TryPopMany(T* out, size_t maxCount) {
+        size_t current = consumerHead;
+        if (cachedTail == current) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (cachedTail == current) return 0;
+        }
+        size_t count = std::min(maxCount, cachedTail - current);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = slots[(current + i) & mask];
+        }
+        consumerHead = current + count;
+        head.store(consumerHead, std::memory_order_release);
+        return count;
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    // Producer-only
+    alignas(64) size_t producerTail = 0;
+    size_t cachedHead = 0;
+    // Consumer-only
+    alignas(64) size_t consumerHead = 0;
+    size_t cachedTail = 0;
+};
+
+#endif // SPSC_QUEUE_H
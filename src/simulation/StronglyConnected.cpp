@@ -0,0 +1,126 @@
+#include "StronglyConnected.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+constexpr uint32_t UNVISITED = UINT32_MAX;
+
+struct Frame {
+    GateId gate;
+    FanoutRange::Iterator next;
+};
+
+} // namespace
+
+SccDecomposition FindStronglyConnectedComponents(const Netlist& netlist) {
+    const size_t gateCount = netlist.GetGateCount();
+    std::vector<uint32_t> indices(gateCount, UNVISITED);
+    std::vector<uint32_t> lowLinks(gateCount, 0);
+    std::vector<uint8_t> onStack(gateCount, 0);
+    std::vector<GateId> stack;
+    std::vector<Frame> frames;
+    uint32_t nextIndex = 0;
+
+    // Tarjan emits components sinks first
+    std::vector<GateId> gates;
+    std::vector<uint32_t> offsets{ 0 };
+    std::vector<uint32_t> gateComponents(gateCount, UNVISITED);
+    const FanoutRange::Iterator end = netlist.GetFanout(Netlist::CONST0).end();
+
+    auto visit = [&](GateId gate) {
+        indices[gate] = lowLinks[gate] = nextIndex++;
+        stack.push_back(gate);
+        onStack[gate] = 1;
+        frames.push_back({ gate, netlist.GetFanout(netlist.GetOutput(gate)).begin() });
+    };
+
+    for (GateId root = 0; root < gateCount; ++root) {
+        if (!netlist.IsValidGate(root) || indices[root] != UNVISITED) continue;
+        visit(root);
+
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            if (frame.next != end) {
+                GateId gate = frame.gate;
+                GateId reader = *frame.next;
+                ++frame.next;
+                if (indices[reader] == UNVISITED) {
+                    visit(reader);
+                } else if (onStack[reader]) {
+                    lowLinks[gate] = std::min(lowLinks[gate], indices[reader]);
+                }
+                continue;
+            }
+
+            GateId gate = frame.gate;
+            frames.pop_back();
+            if (!frames.empty()) {
+                GateId parent = frames.back().gate;
+                lowLinks[parent] = std::min(lowLinks[parent], lowLinks[gate]);
+            }
+            if (lowLinks[gate] != indices[gate]) continue;
+
+            uint32_t component = static_cast<uint32_t>(offsets.size() - 1);
+            GateId member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                onStack[member] = 0;
+                gateComponents[member] = component;
+                gates.push_back(member);
+            } while (member != gate);
+            offsets.push_back(static_cast<uint32_t>(gates.size()));
+        }
+    }
+
+    // Walk components sources first to find cycles and levels
+    const uint32_t componentCount = static_cast<uint32_t>(offsets.size() - 1);
+    std::vector<uint32_t> levels(componentCount, 0);
+    std::vector<uint8_t> cyclic(componentCount, 0);
+    for (uint32_t component = componentCount; component-- > 0;) {
+        for (uint32_t i = offsets[component]; i < offsets[component + 1]; ++i) {
+            for (NetId net : netlist.GetFanin(gates[i])) {
+                GateId driver = netlist.GetDriver(net);
+                if (driver == INVALID_GATE) continue;
+                uint32_t source = gateComponents[driver];
+                if (source == component) {
+                    cyclic[component] = 1;
+                } else {
+                    levels[component] = std::max(levels[component], levels[source] + 1);
+                }
+            }
+        }
+        if (offsets[component + 1] - offsets[component] > 1) {
+            cyclic[component] = 1;
+        }
+    }
+
+    std::vector<uint32_t> componentOrder(componentCount);
+    std::iota(componentOrder.begin(), componentOrder.end(), 0);
+    std::sort(componentOrder.begin(), componentOrder.end(), [&](uint32_t a, uint32_t b) {
+        if (levels[a] != levels[b]) return levels[a] < levels[b];
+        if (cyclic[a] != cyclic[b]) return cyclic[a] < cyclic[b];
+        GateKind kindA = netlist.GetKind(gates[offsets[a]]);
+        GateKind kindB = netlist.GetKind(gates[offsets[b]]);
+        if (kindA != kindB) return kindA < kindB;
+        return gates[offsets[a]] < gates[offsets[b]];
+    });
+
+    SccDecomposition result;
+    result.gates.reserve(gates.size());
+    result.componentOffsets.reserve(componentCount + 1);
+    result.componentLevels.reserve(componentCount);
+    result.componentCyclic.reserve(componentCount);
+    result.componentOffsets.push_back(0);
+    for (uint32_t component : componentOrder) {
+        size_t begin = result.gates.size();
+        result.gates.insert(result.gates.end(), gates.begin() + offsets[component], gates.begin() + offsets[component + 1]);
+        // Loops iterate in slot order so results do not depend on the search
+        std::sort(result.gates.begin() + begin, result.gates.end());
+        result.componentOffsets.push_back(static_cast<uint32_t>(result.gates.size()));
+        result.componentLevels.push_back(levels[component]);
+        result.componentCyclic.push_back(cyclic[component]);
+    }
+    return result;
+}
@@ -0,0 +1,28 @@
+#ifndef STRONGLY_CONNECTED_H
+#define STRONGLY_CONNECTED_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <vector>
+
+// Strongly connected components of the gate graph, where each gate points
+// at the gates reading its output. A component is cyclic when it holds
+// more than one gate or a gate reading itself; every other component is a
+// single acyclic gate.
+//
+// Components are sorted by level in the condensed graph, one more than the
+// deepest component driving them. Within a level acyclic gates come first,
+// grouped by kind, then the cyclic components.
+struct SccDecomposition {
+    std::vector<GateId> gates;                // grouped by component
+    std::vector<uint32_t> componentOffsets;   // component c is gates[componentOffsets[c], componentOffsets[c + 1])
+    std::vector<uint32_t> componentLevels;
+    std::vector<uint8_t> componentCyclic;
+
+    size_t GetComponentCount() const { return componentLevels.size(); }
+};
+
+// Tarjan's algorithm, run iteratively so deep netlists cannot overflow the stack
+SccDecomposition FindStronglyConnectedComponents(const Netlist& netlist);
+
+#endif // STRONGLY_CONNECTED_H
@@ -0,0 +1,158 @@
+#include "Subcircuit.h"
+#include <algorithm>
+
+namespace {
+
+// Scratch for evaluating instances outside of a batch
+struct PortScratch {
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> pins;
+};
+
+// Scratch for EvaluateSubcircuitGates
+struct BatchEntry {
+    const SubcircuitDefinition* definition;
+    SubcircuitId instance;
+    const CompiledGate* op;
+    uint32_t lane;
+};
+
+struct BatchScratch {
+    std::vector<BatchEntry> entries;
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> pins;
+    std::vector<uint64_t> ports;
+};
+
+thread_local PortScratch portScratch;
+thread_local BatchScratch batchScratch;
+
+} // namespace
+
+bool SubcircuitDefinition::Compile(const Netlist& source, std::string& error) {
+    body = source;
+    lowered = LowerToAig(body);
+
+    std::vector<uint32_t> inputNodeOf(body.GetGateCount(), 0);
+    for (const auto& [gate, node] : lowered.inputs) {
+        inputNodeOf[gate] = node;
+    }
+
+    pinNodes.clear();
+    portLiterals.clear();
+    bool probed = body.GetProbeCount() != 0;
+    for (GateId gate = 0; gate < body.GetGateCount(); ++gate) {
+        if (!body.IsValidGate(gate)) continue;
+        bool input = body.GetKind(gate) == GateKind::INPUT;
+        if (input) {
+            pinNodes.push_back(inputNodeOf[gate]);
+        }
+        NetId output = body.GetOutput(gate);
+        if (probed ? body.IsProbed(gate) : !input && body.GetFanout(output).empty()) {
+            portLiterals.push_back(lowered.netLiterals[output]);
+        }
+    }
+    if (portLiterals.empty()) {
+        error = "subcircuit has no outputs";
+        return false;
+    }
+
+    inputCount = pinNodes.size();
+    for (const auto& [net, node] : lowered.loopCuts) {
+        pinNodes.push_back(node);
+        portLiterals.push_back(lowered.netLiterals[net]);
+    }
+    return true;
+}
+
+void SubcircuitDefinition::Evaluate(uint64_t* words, const uint64_t* pins, uint64_t* ports) const {
+    for (size_t pin = 0; pin < pinNodes.size(); ++pin) {
+        words[pinNodes[pin]] = pins[pin];
+    }
+    lowered.aig.Simulate(words);
+    for (size_t port = 0; port < portLiterals.size(); ++port) {
+        ports[port] = Aig::LiteralWord(words, portLiterals[port]);
+    }
+}
+
+uint64_t SubcircuitDefinition::EvaluatePort(const uint64_t* pins, size_t port) const {
+    std::vector<uint64_t>& words = portScratch.words;
+    words.resize(GetWordCount());
+    for (size_t pin = 0; pin < pinNodes.size(); ++pin) {
+        words[pinNodes[pin]] = pins[pin];
+    }
+    lowered.aig.Simulate(words.data());
+    return Aig::LiteralWord(words.data(), portLiterals[port]);
+}
+
+AigLiteral SubcircuitDefinition::LowerPort(Aig& aig, const AigLiteral* pins, size_t port) const {
+    const std::vector<AigNode>& nodes = lowered.aig.GetNodes();
+    std::vector<AigLiteral> nodeLiterals(nodes.size(), AIG_FALSE);
+    auto map = [&](AigLiteral literal) { return nodeLiterals[AigNodeOf(literal)] ^ (literal & 1); };
+
+    for (size_t pin = 0; pin < pinNodes.size(); ++pin) {
+        nodeLiterals[pinNodes[pin]] = pins[pin];
+    }
+    // Shared nodes are hash-consed, so ports lowered one by one share logic
+    for (size_t node = 1; node < nodes.size(); ++node) {
+        if (nodes[node].fanin0 == AIG_INPUT) continue;
+        nodeLiterals[node] = aig.And(map(nodes[node].fanin0), map(nodes[node].fanin1));
+    }
+    return map(portLiterals[port]);
+}
+
+uint8_t EvaluateSubcircuitPort(const Netlist& netlist, GateId gate, const uint8_t* values) {
+    const SubcircuitDefinition& definition = netlist.GetSubcircuitDefinition(netlist.GetSubcircuitOf(gate));
+    std::span<const NetId> fanin = netlist.GetFanin(gate);
+    std::vector<uint64_t>& pins = portScratch.pins;
+    pins.resize(fanin.size());
+    for (size_t pin = 0; pin < fanin.size(); ++pin) {
+        pins[pin] = values[fanin[pin]];
+    }
+    return static_cast<uint8_t>(definition.EvaluatePort(pins.data(), netlist.GetSubcircuitPort(gate)) & 1);
+}
+
+void EvaluateSubcircuitGates(const Netlist& netlist, uint8_t* values, const NetId* fanin,
+                             const CompiledGate* begin, const CompiledGate* end) {
+    BatchScratch& scratch = batchScratch;
+    std::vector<BatchEntry>& entries = scratch.entries;
+    entries.clear();
+    for (const CompiledGate* op = begin; op != end; ++op) {
+        SubcircuitId instance = netlist.GetSubcircuitOf(op->gate);
+        entries.push_back({ &netlist.GetSubcircuitDefinition(instance), instance, op, 0 });
+    }
+    // Ports of one instance next to each other, instances grouped by definition
+    std::sort(entries.begin(), entries.end(), [](const BatchEntry& a, const BatchEntry& b) {
+        return a.definition != b.definition ? a.definition < b.definition : a.instance < b.instance;
+    });
+
+    for (size_t first = 0; first < entries.size();) {
+        const SubcircuitDefinition& definition = *entries[first].definition;
+        const size_t pinCount = definition.GetPinCount();
+        scratch.words.resize(definition.GetWordCount());
+        scratch.pins.assign(pinCount, 0);
+        scratch.ports.resize(definition.GetPortCount());
+
+        // Gather up to 64 instances, one lane each
+        size_t last = first;
+        uint32_t lanes = 0;
+        for (; last < entries.size() && entries[last].definition == &definition; ++last) {
+            if (last == first || entries[last].instance != entries[last - 1].instance) {
+                if (lanes == 64) break;
+                const NetId* in = fanin + entries[last].op->faninBegin;
+                for (size_t pin = 0; pin < pinCount; ++pin) {
+                    scratch.pins[pin] |= uint64_t(values[in[pin]]) << lanes;
+                }
+                ++lanes;
+            }
+            entries[last].lane = lanes - 1;
+        }
+
+        definition.Evaluate(scratch.words.data(), scratch.pins.data(), scratch.ports.data());
+        for (; first < last; ++first) {
+            const BatchEntry& entry = entries[first];
+            uint64_t word = scratch.ports[netlist.GetSubcircuitPort(entry.op->gate)];
+            values[entry.op->output] = static_cast<uint8_t>((word >> entry.lane) & 1);
+        }
+    }
+}
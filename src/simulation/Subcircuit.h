@@ -0,0 +1,65 @@
+#ifndef SUBCIRCUIT_H
+#define SUBCIRCUIT_H
+
+#include "Aig.h"
+#include "CompiledNetlist.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Reusable circuit block, such as a full adder, compiled once and shared by
+// every instance. The body's INPUT gates, in slot order, are the input
+// ports; its probed gates, or without probes every non-INPUT gate nothing
+// in the body reads, are the output ports in slot order.
+//
+// The body is lowered to an AIG, so one pass evaluates 64 instances side by
+// side. Combinational loops are cut as in LowerToAig, and the values of the
+// cut nets are all the state an instance keeps between steps.
+//
+// Instances live in a parent netlist (Netlist::AddSubcircuit) as SUBCIRCUIT
+// gates, so they are levelized and evaluated within the parent's step like
+// any other gate. An instance's pins are its input ports followed by its
+// state bits; its ports are its output ports followed by the next value of
+// each state bit.
+class SubcircuitDefinition {
+public:
+    bool Compile(const Netlist& body, std::string& error);
+
+    const Netlist& GetBody() const { return body; }
+    size_t GetInputCount() const { return inputCount; }
+    size_t GetOutputCount() const { return portLiterals.size() - GetStateBitCount(); }
+    size_t GetStateBitCount() const { return lowered.loopCuts.size(); }
+    size_t GetPinCount() const { return pinNodes.size(); }
+    size_t GetPortCount() const { return portLiterals.size(); }
+
+    // Evaluates 64 instances, one per lane. words holds GetWordCount()
+    // scratch words; pins and ports hold one word per pin and port.
+    size_t GetWordCount() const { return lowered.aig.GetNodeCount(); }
+    void Evaluate(uint64_t* words, const uint64_t* pins, uint64_t* ports) const;
+    // One port over 64 lanes, with scratch words kept per thread
+    uint64_t EvaluatePort(const uint64_t* pins, size_t port) const;
+
+    // Copies the body into another AIG, reading the given pin literals, and
+    // returns the literal of one port
+    AigLiteral LowerPort(Aig& aig, const AigLiteral* pins, size_t port) const;
+
+private:
+    Netlist body;
+    AigNetlist lowered;
+    size_t inputCount = 0;
+    // Input nodes, then loop cut nodes
+    std::vector<uint32_t> pinNodes;
+    // Output literals, then the literals computing each cut net
+    std::vector<AigLiteral> portLiterals;
+};
+
+// Value of one SUBCIRCUIT gate from one 0/1 byte per net
+uint8_t EvaluateSubcircuitPort(const Netlist& netlist, GateId gate, const uint8_t* values);
+
+// Evaluates SUBCIRCUIT gates [begin, end) that do not read each other.
+// Instances sharing a definition go through its AIG 64 at a time, and an
+// instance is evaluated once however many of its ports are in the run.
+void EvaluateSubcircuitGates(const Netlist& netlist, uint8_t* values, const NetId* fanin,
+                             const CompiledGate* begin, const CompiledGate* end);
+
+#endif // SUBCIRCUIT_H
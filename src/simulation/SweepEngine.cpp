@@ -0,0 +1,11 @@
+#include "SweepEngine.h"
+#include "Netlist.h"
+
+void SweepEngine::Step(Netlist& netlist) {
+    size_t gateCount = netlist.GetGateCount();
+    for (GateId gate = 0; gate < gateCount; ++gate) {
+        if (netlist.GetKind(gate) == GateKind::NONE) continue;
+        netlist.SetNetValue(netlist.GetOutput(gate), netlist.Evaluate(gate));
+    }
+    netlist.ClearDirtyGates();
+}
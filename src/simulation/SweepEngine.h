@@ -0,0 +1,15 @@
+#ifndef SWEEP_ENGINE_H
+#define SWEEP_ENGINE_H
+
+#include "Engine.h"
+
+// Evaluates every gate once per step in slot order, reading the net values
+// left by earlier gates. A change moves forward one logic level per step
+// unless gates happen to be stored in dependency order.
+class SweepEngine : public Engine {
+public:
+    const char* GetName() const override { return "Sweep"; }
+    void Step(Netlist& netlist) override;
+};
+
+#endif // SWEEP_ENGINE_H
@@ -0,0 +1,153 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+thread_local bool insidePoolTask = false;
+
+uint64_t PackRange(uint32_t begin, uint32_t end) {
+    return static_cast<uint64_t>(end) << 32 | begin;
+}
+
+uint32_t RangeBegin(uint64_t range) { return static_cast<uint32_t>(range); }
+uint32_t RangeEnd(uint64_t range) { return static_cast<uint32_t>(range >> 32); }
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    ranges = std::make_unique<TaskRange[]>(threadCount);
+    for (unsigned slot = 1; slot < threadCount; ++slot) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, slot);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::GetShared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    if (workers.empty() || count == 1 || insidePoolTask) {
+        for (size_t i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    // Ranges hold 32-bit indices; split anything larger into several rounds
+    const size_t maxRound = UINT32_MAX;
+    if (count > maxRound) {
+        for (size_t base = 0; base < count; base += maxRound) {
+            size_t round = std::min(maxRound, count - base);
+            ParallelFor(round, [&](size_t i) { body(base + i); });
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock(callMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &body;
+        taskCount = count;
+        finishedTasks = 0;
+
+        const unsigned threads = GetThreadCount();
+        for (unsigned slot = 0; slot < threads; ++slot) {
+            uint32_t begin = static_cast<uint32_t>(count * slot / threads);
+            uint32_t end = static_cast<uint32_t>(count * (slot + 1) / threads);
+            ranges[slot].range.store(PackRange(begin, end), std::memory_order_relaxed);
+        }
+        generation.fetch_add(1, std::memory_order_release);
+    }
+    workReady.notify_all();
+
+    RunTasks(0);
+
+    // Wait for the last task and for every worker to let go of this job
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this] { return finishedTasks == taskCount && activeWorkers == 0; });
+    task = nullptr;
+}
+
+void ThreadPool::WorkerLoop(unsigned slot) {
+    uint64_t seenGeneration = 0;
+    while (true) {
+        for (int spin = 0; spin < SPIN_COUNT; ++spin) {
+            if (generation.load(std::memory_order_acquire) != seenGeneration) break;
+            std::this_thread::yield();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workReady.wait(lock, [&] { return stopping || (generation != seenGeneration && task); });
+            if (stopping) return;
+            seenGeneration = generation;
+            ++activeWorkers;
+        }
+
+        RunTasks(slot);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --activeWorkers;
+        }
+        workDone.notify_all();
+    }
+}
+
+void ThreadPool::RunTasks(unsigned slot) {
+    insidePoolTask = true;
+    do {
+        uint32_t index;
+        while (ClaimOwn(slot, index)) {
+            (*task)(index);
+            finishedTasks.fetch_add(1, std::memory_order_acq_rel);
+        }
+    } while (Steal(slot));
+    insidePoolTask = false;
+}
+
+bool ThreadPool::ClaimOwn(unsigned slot, uint32_t& index) {
+    std::atomic<uint64_t>& own = ranges[slot].range;
+    uint64_t range = own.load(std::memory_order_acquire);
+    while (RangeBegin(range) < RangeEnd(range)) {
+        if (own.compare_exchange_weak(range, PackRange(RangeBegin(range) + 1, RangeEnd(range)),
+                                      std::memory_order_acq_rel)) {
+            index = RangeBegin(range);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::Steal(unsigned slot) {
+    // Take the back half of the first non-empty range after our own
+    const unsigned threads = GetThreadCount();
+    for (unsigned offset = 1; offset < threads; ++offset) {
+        std::atomic<uint64_t>& victim = ranges[(slot + offset) % threads].range;
+        uint64_t range = victim.load(std::memory_order_acquire);
+        while (RangeBegin(range) < RangeEnd(range)) {
+            uint32_t begin = RangeBegin(range);
+            uint32_t end = RangeEnd(range);
+            uint32_t middle = begin + (end - begin) / 2;
+            if (victim.compare_exchange_weak(range, PackRange(begin, middle), std::memory_order_acq_rel)) {
+                ranges[slot].range.store(PackRange(middle, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
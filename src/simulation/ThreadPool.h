@@ -0,0 +1,67 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. ParallelFor deals
+// each thread an equal share of the indices up front; a thread that runs
+// dry steals half of the remaining share of another, so uneven tasks
+// balance themselves. The calling thread takes part too. Calls from inside
+// a task run inline.
+class ThreadPool {
+public:
+    // 0 uses one thread per hardware thread, counting the caller
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Workers plus the calling thread
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Runs task(i) for every i in [0, count) and returns when all are done,
+    // so back-to-back calls act as a barrier
+    void ParallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    static ThreadPool& GetShared();
+
+private:
+    // Unclaimed indices [begin, end) of one thread, packed as end << 32 | begin
+    // so the owner and thieves can both update it with one compare-exchange
+    struct alignas(64) TaskRange {
+        std::atomic<uint64_t> range{0};
+    };
+
+    // Polls before sleeping so workers catch the next level of a tight loop
+    static constexpr int SPIN_COUNT = 2000;
+
+    void WorkerLoop(unsigned slot);
+    void RunTasks(unsigned slot);
+    bool ClaimOwn(unsigned slot, uint32_t& index);
+    bool Steal(unsigned slot);
+
+    std::vector<std::thread> workers;
+    std::unique_ptr<TaskRange[]> ranges;
+    std::mutex callMutex;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    std::atomic<uint64_t> generation{0};
+    unsigned activeWorkers = 0;
+    bool stopping = false;
+
+    const std::function<void(size_t)>* task = nullptr;
+    size_t taskCount = 0;
+    std::atomic<size_t> finishedTasks{0};
+};
+
+#endif // THREAD_POOL_H
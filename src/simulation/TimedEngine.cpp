@@ -0,0 +1,85 @@
+#include "TimedEngine.h"
+
+const char* TimedEngine::GetName() const {
+    return model == DelayModel::TRANSPORT ? "Timed (transport)" : "Timed (inertial)";
+}
+
+void TimedEngine::Step(Netlist& netlist) {
+    Resize(netlist);
+
+    // The first step has no previous values to trust, so evaluate everything
+    // once against the values the nets hold now (another engine may have run)
+    if (!primed) {
+        for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+            if (netlist.IsValidGate(gate)) {
+                projectedValues[gate] = netlist.GetNetValue(netlist.GetOutput(gate));
+                MarkForEvaluation(gate);
+            }
+        }
+        primed = true;
+    }
+
+    // Edited gates restart from the value their net holds now
+    for (GateId gate : netlist.GetDirtyGates()) {
+        if (netlist.IsValidGate(gate)) {
+            ++stamps[gate];
+            projectedValues[gate] = netlist.GetNetValue(netlist.GetOutput(gate));
+            MarkForEvaluation(gate);
+        }
+    }
+    netlist.ClearDirtyGates();
+
+    changedNets.clear();
+    dueEvents.clear();
+    wheel.TakeDue(dueEvents);
+    for (const TimingWheel::Event& event : dueEvents) {
+        if (!netlist.IsValidGate(event.gate) || event.stamp != stamps[event.gate]) continue;
+        NetId output = netlist.GetOutput(event.gate);
+        if (netlist.GetNetValue(output) == static_cast<bool>(event.value)) continue;
+        netlist.SetNetValue(output, event.value);
+        changedNets.push_back(output);
+        for (GateId reader : netlist.GetFanout(output)) {
+            MarkForEvaluation(reader);
+        }
+    }
+
+    for (GateId gate : evaluateGates) {
+        isMarked[gate] = 0;
+        Evaluate(netlist, gate);
+    }
+    evaluateGates.clear();
+    wheel.Advance();
+}
+
+void TimedEngine::Resize(const Netlist& netlist) {
+    size_t gateCount = netlist.GetGateCount();
+    if (isMarked.size() < gateCount) {
+        isMarked.resize(gateCount, 0);
+        projectedValues.resize(gateCount, 0);
+        stamps.resize(gateCount, 0);
+    }
+}
+
+void TimedEngine::MarkForEvaluation(GateId gate) {
+    if (!isMarked[gate]) {
+        isMarked[gate] = 1;
+        evaluateGates.push_back(gate);
+    }
+}
+
+void TimedEngine::Evaluate(const Netlist& netlist, GateId gate) {
+    if (!netlist.IsValidGate(gate)) return;
+    uint8_t value = netlist.Evaluate(gate) ? 1 : 0;
+    if (value == projectedValues[gate]) return;
+
+    if (model == DelayModel::INERTIAL) {
+        // Drop the pending change this one overrides; if the output already
+        // holds the new value the pulse is gone entirely
+        ++stamps[gate];
+        projectedValues[gate] = value;
+        if (netlist.GetNetValue(netlist.GetOutput(gate)) == static_cast<bool>(value)) return;
+    }
+
+    projectedValues[gate] = value;
+    wheel.Schedule(wheel.GetTime() + netlist.GetGateDelay(gate), { gate, stamps[gate], value });
+}
@@ -0,0 +1,53 @@
+#ifndef TIMED_ENGINE_H
+#define TIMED_ENGINE_H
+
+#include "Engine.h"
+#include "Netlist.h"
+#include "TimingWheel.h"
+#include <cstdint>
+#include <vector>
+
+// How a gate's delay treats short input pulses
+enum class DelayModel {
+    TRANSPORT,  // every output change arrives after the delay, however brief
+    INERTIAL    // a change that reverts within the delay is swallowed
+};
+
+// Event-driven simulation with per-gate propagation delays. Each step is
+// one time unit: output changes due now are applied, the gates reading the
+// changed nets are evaluated, and their new outputs are scheduled on a
+// timing wheel at now plus their delay. Gates edited or reset outside the
+// engine drop their pending changes and are evaluated afresh.
+class TimedEngine : public Engine {
+public:
+    explicit TimedEngine(DelayModel model = DelayModel::INERTIAL) : model(model) {}
+
+    const char* GetName() const override;
+    void Step(Netlist& netlist) override;
+    const std::vector<NetId>* GetChangedNets() const override { return &changedNets; }
+
+    void SetDelayModel(DelayModel newModel) { model = newModel; }
+    DelayModel GetDelayModel() const { return model; }
+
+    uint64_t GetTime() const { return wheel.GetTime(); }
+    size_t GetPendingEventCount() const { return wheel.GetPendingCount(); }
+
+private:
+    void Resize(const Netlist& netlist);
+    void MarkForEvaluation(GateId gate);
+    void Evaluate(const Netlist& netlist, GateId gate);
+
+    DelayModel model;
+    TimingWheel wheel;
+    std::vector<TimingWheel::Event> dueEvents;
+    std::vector<GateId> evaluateGates;
+    std::vector<uint8_t> isMarked;
+    std::vector<NetId> changedNets;
+    // Per gate: the output value once every pending change has landed, and
+    // a stamp that invalidates pending changes when bumped
+    std::vector<uint8_t> projectedValues;
+    std::vector<uint32_t> stamps;
+    bool primed = false;
+};
+
+#endif // TIMED_ENGINE_H
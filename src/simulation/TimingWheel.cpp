@@ -0,0 +1,79 @@
+#include "TimingWheel.h"
+
+TimingWheel::TimingWheel() {
+    Clear();
+}
+
+void TimingWheel::Clear() {
+    entries.clear();
+    freeEntries = NO_EVENT;
+    for (auto& wheel : slots) {
+        wheel.fill(NO_EVENT);
+    }
+    now = 0;
+    pendingCount = 0;
+}
+
+void TimingWheel::Schedule(uint64_t time, const Event& event) {
+    uint32_t entry;
+    if (freeEntries != NO_EVENT) {
+        entry = freeEntries;
+        freeEntries = entries[entry].next;
+    } else {
+        entry = static_cast<uint32_t>(entries.size());
+        entries.push_back({});
+    }
+    entries[entry].time = time;
+    entries[entry].event = event;
+    Insert(entry);
+    ++pendingCount;
+}
+
+void TimingWheel::Insert(uint32_t entry) {
+    // The first wheel whose span covers the distance; slots are indexed by
+    // absolute time so an entry is reached exactly when its wheel turns to it
+    uint64_t time = entries[entry].time;
+    uint64_t distance = time - now;
+    int wheel = 0;
+    while (wheel < WHEEL_COUNT - 1 && distance >= (uint64_t(1) << (SLOT_BITS * (wheel + 1)))) {
+        ++wheel;
+    }
+    uint32_t& head = slots[wheel][(time >> (SLOT_BITS * wheel)) & SLOT_MASK];
+    entries[entry].next = head;
+    head = entry;
+}
+
+void TimingWheel::TakeDue(std::vector<Event>& due) {
+    uint32_t& head = slots[0][now & SLOT_MASK];
+    uint32_t entry = head;
+    head = NO_EVENT;
+    while (entry != NO_EVENT) {
+        uint32_t next = entries[entry].next;
+        due.push_back(entries[entry].event);
+        entries[entry].next = freeEntries;
+        freeEntries = entry;
+        --pendingCount;
+        entry = next;
+    }
+}
+
+void TimingWheel::Advance() {
+    ++now;
+    // Coarsest first, so entries can fall through several wheels at once
+    for (int wheel = WHEEL_COUNT - 1; wheel > 0; --wheel) {
+        if ((now & ((uint64_t(1) << (SLOT_BITS * wheel)) - 1)) == 0) {
+            Cascade(wheel);
+        }
+    }
+}
+
+void TimingWheel::Cascade(int wheel) {
+    uint32_t& head = slots[wheel][(now >> (SLOT_BITS * wheel)) & SLOT_MASK];
+    uint32_t entry = head;
+    head = NO_EVENT;
+    while (entry != NO_EVENT) {
+        uint32_t next = entries[entry].next;
+        Insert(entry);
+        entry = next;
+    }
+}
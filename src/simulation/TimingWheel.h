@@ -0,0 +1,60 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include "Netlist.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel of pending gate output changes. Four wheels of
+// 256 slots cover 2^32 time units ahead of the current time; an event lands
+// in the finest wheel that spans its distance and drops down a wheel each
+// time the coarser one turns over, so scheduling and firing are O(1) no
+// matter how many events are pending. Events live in one pooled array
+// linked through indices, so scheduling does not allocate once warm.
+class TimingWheel {
+public:
+    struct Event {
+        GateId gate;
+        uint32_t stamp;  // lets the owner cancel events without finding them
+        uint8_t value;
+    };
+
+    TimingWheel();
+
+    void Clear();
+
+    uint64_t GetTime() const { return now; }
+    size_t GetPendingCount() const { return pendingCount; }
+
+    // time must not be in the past, nor more than 2^32 - 1 units ahead
+    void Schedule(uint64_t time, const Event& event);
+    // Appends the events due at the current time, in no particular order
+    void TakeDue(std::vector<Event>& due);
+    // Moves to the next time unit
+    void Advance();
+
+private:
+    static constexpr int WHEEL_COUNT = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr uint32_t SLOT_COUNT = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr uint32_t NO_EVENT = UINT32_MAX;
+
+    struct Entry {
+        uint64_t time;
+        Event event;
+        uint32_t next;
+    };
+
+    void Insert(uint32_t entry);
+    void Cascade(int wheel);
+
+    std::vector<Entry> entries;
+    uint32_t freeEntries = NO_EVENT;
+    std::array<std::array<uint32_t, SLOT_COUNT>, WHEEL_COUNT> slots;
+    uint64_t now = 0;
+    size_t pendingCount = 0;
+};
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,67 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <cstdint>
+
+// On-disk layout of binary waveform traces, little-endian:
+//
+//   TraceHeader
+//   change blocks, in the order they filled up
+//   TraceFooter
+//   TraceSignal[signalCount]
+//   TraceBlock[blockCount], grouped by signal and sorted by time
+//   signal names, back to back
+//   TraceTrailer
+//
+// Signals are single bits, so a block only stores when its signal toggled:
+// the first change time sits in the index, the rest follow as varint gaps.
+// The value after each change is the block's start value flipped once per
+// change.
+
+constexpr char TRACE_MAGIC[8] = { 'L', 'C', 'S', 'T', 'R', 'A', 'C', 'E' };
+constexpr char TRACE_END_MAGIC[8] = { 'L', 'C', 'S', 'T', 'E', 'N', 'D', '!' };
+constexpr uint32_t TRACE_VERSION = 2;
+// Changes per block; a lookup decodes at most one block
+constexpr uint32_t TRACE_BLOCK_CHANGES = 256;
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+struct TraceFooter {
+    uint64_t startTime;
+    uint64_t endTime;
+    uint32_t signalCount;
+    uint32_t blockCount;
+};
+
+struct TraceSignal {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t firstBlock;
+    uint32_t blockCount;
+    uint8_t initialValue;
+    uint8_t padding[7];  // keeps the block index after the table 8-byte aligned
+};
+
+struct TraceBlock {
+    uint64_t firstTime;
+    uint64_t lastTime;
+    uint64_t offset;
+    uint32_t size;
+    uint32_t changeCount;
+    uint8_t startValue;  // value before the block's first change
+    uint8_t padding[7];
+};
+
+struct TraceTrailer {
+    uint64_t footerOffset;
+    char magic[8];
+};
+
+static_assert(sizeof(TraceFooter) % 8 == 0 && sizeof(TraceSignal) % 8 == 0 && sizeof(TraceBlock) == 40,
+              "the index is read in place and must stay 8-byte aligned");
+
+#endif // TRACE_FORMAT_H
@@ -0,0 +1,276 @@
+#include "TraceReader.h"
+#include "VcdWriter.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <queue>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+// Stops at `end`, so a corrupt block cannot read past itself
+uint64_t ReadVarint(const uint8_t*& in, const uint8_t* end) {
+    uint64_t value = 0;
+    for (int shift = 0; in < end && shift < 64; shift += 7) {
+        uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) break;
+    }
+    return value;
+}
+
+// Walks the changes of one block in time order
+class BlockCursor {
+public:
+    BlockCursor(const uint8_t* data, const TraceBlock& block)
+        : in(data + block.offset), end(in + block.size), remaining(block.changeCount), time(block.firstTime),
+          value(block.startValue) {}
+
+    bool Next() {
+        if (remaining == 0) return false;
+        if (started) time += ReadVarint(in, end);
+        started = true;
+        value ^= 1;
+        --remaining;
+        return true;
+    }
+    uint64_t GetTime() const { return time; }
+    uint8_t GetValue() const { return value; }
+
+private:
+    const uint8_t* in;
+    const uint8_t* end;
+    uint32_t remaining;
+    uint64_t time;
+    uint8_t value;
+    bool started = false;
+};
+
+} // namespace
+
+TraceReader::~TraceReader() {
+    Close();
+}
+
+bool TraceReader::Open(const std::string& path, std::string& error) {
+    Close();
+#if defined(_WIN32)
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    contents.resize(static_cast<size_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+    size_t read = std::fread(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+    if (read != contents.size()) {
+        error = "cannot read " + path;
+        return false;
+    }
+    data = contents.data();
+    size = contents.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        error = "cannot read " + path;
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        error = "cannot map " + path;
+        return false;
+    }
+    data = static_cast<const uint8_t*>(mapping);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    TraceHeader header;
+    TraceTrailer trailer;
+    bool valid = size >= sizeof(header) + sizeof(footer) + sizeof(trailer);
+    if (valid) {
+        std::memcpy(&header, data, sizeof(header));
+        std::memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+        valid = std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) == 0 &&
+                std::memcmp(trailer.magic, TRACE_END_MAGIC, sizeof(trailer.magic)) == 0 &&
+                header.version == TRACE_VERSION && trailer.footerOffset % 8 == 0 &&
+                trailer.footerOffset + sizeof(footer) <= size - sizeof(trailer);
+    }
+    if (valid) {
+        std::memcpy(&footer, data + trailer.footerOffset, sizeof(footer));
+        uint64_t signalsOffset = trailer.footerOffset + sizeof(footer);
+        uint64_t blocksOffset = signalsOffset + uint64_t(footer.signalCount) * sizeof(TraceSignal);
+        uint64_t namesOffset = blocksOffset + uint64_t(footer.blockCount) * sizeof(TraceBlock);
+        valid = namesOffset <= size - sizeof(trailer);
+        if (valid) {
+            signals = reinterpret_cast<const TraceSignal*>(data + signalsOffset);
+            blocks = reinterpret_cast<const TraceBlock*>(data + blocksOffset);
+            names = reinterpret_cast<const char*>(data + namesOffset);
+        }
+
+        // Every range the index points at must lie inside its section, so a
+        // truncated or corrupt file fails here instead of on a lookup
+        uint64_t namesSize = size - sizeof(trailer) - namesOffset;
+        for (uint32_t signal = 0; valid && signal < footer.signalCount; ++signal) {
+            const TraceSignal& entry = signals[signal];
+            valid = uint64_t(entry.firstBlock) + entry.blockCount <= footer.blockCount &&
+                    uint64_t(entry.nameOffset) + entry.nameLength <= namesSize;
+        }
+        for (uint32_t block = 0; valid && block < footer.blockCount; ++block) {
+            const TraceBlock& entry = blocks[block];
+            valid = entry.offset >= sizeof(header) && entry.offset <= trailer.footerOffset &&
+                    entry.size <= trailer.footerOffset - entry.offset &&
+                    entry.changeCount <= TRACE_BLOCK_CHANGES && entry.changeCount <= uint64_t(entry.size) + 1;
+        }
+    }
+    if (!valid) {
+        Close();
+        error = path + " is not a trace file";
+        return false;
+    }
+    return true;
+}
+
+void TraceReader::Close() {
+#if defined(_WIN32)
+    contents.clear();
+#else
+    if (data) {
+        ::munmap(const_cast<uint8_t*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    footer = {};
+    signals = nullptr;
+    blocks = nullptr;
+    names = nullptr;
+}
+
+std::string_view TraceReader::GetSignalName(uint32_t signal) const {
+    return std::string_view(names + signals[signal].nameOffset, signals[signal].nameLength);
+}
+
+ptrdiff_t TraceReader::FindBlock(const TraceSignal& signal, uint64_t time) const {
+    const TraceBlock* begin = blocks + signal.firstBlock;
+    const TraceBlock* end = begin + signal.blockCount;
+    const TraceBlock* after = std::upper_bound(begin, end, time,
+                                               [](uint64_t t, const TraceBlock& block) { return t < block.firstTime; });
+    return (after - begin) - 1;
+}
+
+uint8_t TraceReader::GetValue(uint32_t signal, uint64_t time) const {
+    const TraceSignal& entry = signals[signal];
+    ptrdiff_t index = FindBlock(entry, time);
+    if (index < 0) return entry.initialValue;
+
+    const TraceBlock& block = blocks[entry.firstBlock + index];
+    if (time >= block.lastTime) return block.startValue ^ (block.changeCount & 1);
+    BlockCursor cursor(data, block);
+    uint8_t value = block.startValue;
+    while (cursor.Next() && cursor.GetTime() <= time) {
+        value = cursor.GetValue();
+    }
+    return value;
+}
+
+uint8_t TraceReader::GetChanges(uint32_t signal, uint64_t begin, uint64_t end, std::vector<TraceChange>& changes) const {
+    const TraceSignal& entry = signals[signal];
+    uint8_t initial = GetValue(signal, begin);
+    ptrdiff_t index = std::max<ptrdiff_t>(FindBlock(entry, begin), 0);
+    for (; index < static_cast<ptrdiff_t>(entry.blockCount); ++index) {
+        const TraceBlock& block = blocks[entry.firstBlock + index];
+        if (block.firstTime > end) break;
+        if (block.lastTime <= begin) continue;
+        BlockCursor cursor(data, block);
+        while (cursor.Next() && cursor.GetTime() <= end) {
+            if (cursor.GetTime() > begin) changes.push_back({ cursor.GetTime(), cursor.GetValue() });
+        }
+    }
+    return initial;
+}
+
+bool ExportTraceToVcd(const TraceReader& trace, const std::string& path, std::string& error) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "cannot write " + path;
+        return false;
+    }
+
+    uint32_t signalCount = static_cast<uint32_t>(trace.GetSignalCount());
+    std::vector<std::string> names;
+    std::vector<std::string> identifiers;
+    std::vector<uint8_t> initialValues;
+    for (uint32_t signal = 0; signal < signalCount; ++signal) {
+        names.emplace_back(trace.GetSignalName(signal));
+        identifiers.push_back(VcdWriter::MakeIdentifier(signal));
+        initialValues.push_back(trace.GetValue(signal, trace.GetStartTime()));
+    }
+    std::string buffer;
+    AppendVcdHeader(buffer, names, identifiers, initialValues, trace.GetStartTime());
+
+    // k-way merge of the signals' change streams by time
+    std::vector<BlockCursor> cursors;
+    std::vector<uint32_t> nextBlocks(signalCount);
+    using Pending = std::pair<uint64_t, uint32_t>;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<>> pending;
+    cursors.reserve(signalCount);
+    for (uint32_t signal = 0; signal < signalCount; ++signal) {
+        const TraceSignal& entry = trace.signals[signal];
+        static const TraceBlock EMPTY_BLOCK = {};
+        cursors.emplace_back(trace.data, entry.blockCount != 0 ? trace.blocks[entry.firstBlock] : EMPTY_BLOCK);
+        nextBlocks[signal] = 1;
+        if (cursors[signal].Next()) {
+            pending.push({ cursors[signal].GetTime(), signal });
+        }
+    }
+
+    uint64_t time = UINT64_MAX;
+    while (!pending.empty()) {
+        uint32_t signal = pending.top().second;
+        pending.pop();
+        BlockCursor& cursor = cursors[signal];
+        if (cursor.GetTime() != time) {
+            time = cursor.GetTime();
+            buffer += '#';
+            buffer += std::to_string(time);
+            buffer += '\n';
+        }
+        buffer += static_cast<char>('0' + cursor.GetValue());
+        buffer += identifiers[signal];
+        buffer += '\n';
+        if (buffer.size() >= WRITE_BUFFER_SIZE) {
+            std::fwrite(buffer.data(), 1, buffer.size(), file);
+            buffer.clear();
+        }
+
+        const TraceSignal& entry = trace.signals[signal];
+        bool more = cursor.Next();
+        if (!more && nextBlocks[signal] < entry.blockCount) {
+            cursor = BlockCursor(trace.data, trace.blocks[entry.firstBlock + nextBlocks[signal]++]);
+            more = cursor.Next();
+        }
+        if (more) pending.push({ cursor.GetTime(), signal });
+    }
+    std::fwrite(buffer.data(), 1, buffer.size(), file);
+    bool written = std::fclose(file) == 0;
+    if (!written) error = "cannot write " + path;
+    return written;
+}
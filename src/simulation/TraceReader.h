@@ -0,0 +1,61 @@
+#ifndef TRACE_READER_H
+#define TRACE_READER_H
+
+#include "TraceFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct TraceChange {
+    uint64_t time;
+    uint8_t value;  // held from `time` on
+};
+
+// Random access to a binary trace (see TraceFormat.h). The file is memory
+// mapped and the index is bounds-checked on open; a lookup binary-searches
+// the signal's block index and decodes a single block.
+class TraceReader {
+public:
+    TraceReader() = default;
+    ~TraceReader();
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    bool Open(const std::string& path, std::string& error);
+    void Close();
+    bool IsOpen() const { return data != nullptr; }
+
+    size_t GetSignalCount() const { return footer.signalCount; }
+    std::string_view GetSignalName(uint32_t signal) const;
+    uint64_t GetStartTime() const { return footer.startTime; }
+    uint64_t GetEndTime() const { return footer.endTime; }
+
+    // Value the signal holds at `time`
+    uint8_t GetValue(uint32_t signal, uint64_t time) const;
+    // Appends the changes in (begin, end] and returns the value at `begin`
+    uint8_t GetChanges(uint32_t signal, uint64_t begin, uint64_t end, std::vector<TraceChange>& changes) const;
+
+private:
+    // Index of the last block of the signal starting at or before `time`, or -1
+    ptrdiff_t FindBlock(const TraceSignal& signal, uint64_t time) const;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    std::vector<uint8_t> contents;
+#endif
+    TraceFooter footer = {};
+    const TraceSignal* signals = nullptr;
+    const TraceBlock* blocks = nullptr;
+    const char* names = nullptr;
+
+    friend bool ExportTraceToVcd(const TraceReader& trace, const std::string& path, std::string& error);
+};
+
+// Rewrites a trace as a Value Change Dump, merging the signals in time order
+bool ExportTraceToVcd(const TraceReader& trace, const std::string& path, std::string& error);
+
+#endif // TRACE_READER_H
@@ -0,0 +1,116 @@
+#include "TraceWriter.h"
+#include <algorithm>
+#include <cstring>
+
+TraceWriter::~TraceWriter() {
+    Close();
+}
+
+void TraceWriter::WriteHeader(const std::vector<std::string>& names, const std::vector<uint8_t>& initial,
+                              uint64_t tick) {
+    signalNames = names;
+    initialValues = initial;
+    values = initial;
+    openBlocks.assign(names.size(), OpenBlock());
+    blocks.assign(names.size(), {});
+    startTime = tick;
+    time = tick;
+
+    TraceHeader header = {};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    std::fwrite(&header, sizeof(header), 1, file);
+    fileOffset = sizeof(header);
+}
+
+void TraceWriter::WriteTick(uint64_t tick) {
+    time = tick;
+}
+
+void TraceWriter::WriteChange(uint32_t signal, uint8_t value) {
+    // Values resent after a drop may not be changes at all
+    if (values[signal] == value) return;
+    values[signal] = value;
+
+    OpenBlock& block = openBlocks[signal];
+    if (block.changeCount == 0) {
+        block.firstTime = time;
+        block.startValue = value ^ 1;
+    } else {
+        uint64_t gap = time - block.lastTime;
+        while (gap >= 0x80) {
+            block.data.push_back(static_cast<uint8_t>(gap | 0x80));
+            gap >>= 7;
+        }
+        block.data.push_back(static_cast<uint8_t>(gap));
+    }
+    block.lastTime = time;
+    if (++block.changeCount == TRACE_BLOCK_CHANGES) {
+        WriteBlock(signal);
+    }
+}
+
+void TraceWriter::Flush() {
+    // Full blocks are already written; the open ones wait for the footer
+    std::fflush(file);
+}
+
+void TraceWriter::WriteBlock(uint32_t signal) {
+    OpenBlock& open = openBlocks[signal];
+    TraceBlock block = {};
+    block.firstTime = open.firstTime;
+    block.lastTime = open.lastTime;
+    block.offset = fileOffset;
+    block.size = static_cast<uint32_t>(open.data.size());
+    block.changeCount = open.changeCount;
+    block.startValue = open.startValue;
+    blocks[signal].push_back(block);
+
+    std::fwrite(open.data.data(), 1, open.data.size(), file);
+    fileOffset += open.data.size();
+    open.data.clear();
+    open.changeCount = 0;
+}
+
+void TraceWriter::WriteFooter(uint64_t lastTick) {
+    for (uint32_t signal = 0; signal < openBlocks.size(); ++signal) {
+        if (openBlocks[signal].changeCount != 0) WriteBlock(signal);
+    }
+
+    // The index is read in place, so align it
+    static const uint8_t zeros[8] = {};
+    size_t padding = (8 - fileOffset % 8) % 8;
+    std::fwrite(zeros, 1, padding, file);
+    fileOffset += padding;
+
+    TraceFooter footer = {};
+    footer.startTime = startTime;
+    footer.endTime = std::max(lastTick, time);
+    footer.signalCount = static_cast<uint32_t>(signalNames.size());
+    uint64_t footerOffset = fileOffset;
+
+    std::vector<TraceSignal> signals(signalNames.size());
+    std::vector<TraceBlock> index;
+    std::string names;
+    for (size_t signal = 0; signal < signalNames.size(); ++signal) {
+        TraceSignal& entry = signals[signal];
+        entry = {};
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint32_t>(signalNames[signal].size());
+        entry.firstBlock = static_cast<uint32_t>(index.size());
+        entry.blockCount = static_cast<uint32_t>(blocks[signal].size());
+        entry.initialValue = initialValues[signal];
+        names += signalNames[signal];
+        index.insert(index.end(), blocks[signal].begin(), blocks[signal].end());
+    }
+    footer.blockCount = static_cast<uint32_t>(index.size());
+
+    std::fwrite(&footer, sizeof(footer), 1, file);
+    if (!signals.empty()) std::fwrite(signals.data(), sizeof(TraceSignal), signals.size(), file);
+    if (!index.empty()) std::fwrite(index.data(), sizeof(TraceBlock), index.size(), file);
+    std::fwrite(names.data(), 1, names.size(), file);
+    TraceTrailer trailer = {};
+    trailer.footerOffset = footerOffset;
+    std::memcpy(trailer.magic, TRACE_END_MAGIC, sizeof(trailer.magic));
+    std::fwrite(&trailer, sizeof(trailer), 1, file);
+}
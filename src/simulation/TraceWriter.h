@@ -0,0 +1,46 @@
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include "TraceFormat.h"
+#include "WaveformWriter.h"
+#include <vector>
+
+// Streams waveforms into the binary trace format (see TraceFormat.h). Each
+// signal fills its own block of delta-coded change times; full blocks are
+// appended to the file as they complete and the block index is written
+// when the trace is closed.
+class TraceWriter : public WaveformWriter {
+public:
+    using WaveformWriter::WaveformWriter;
+    ~TraceWriter() override;
+
+protected:
+    void WriteHeader(const std::vector<std::string>& names, const std::vector<uint8_t>& initialValues,
+                     uint64_t tick) override;
+    void WriteTick(uint64_t tick) override;
+    void WriteChange(uint32_t signal, uint8_t value) override;
+    void Flush() override;
+    void WriteFooter(uint64_t lastTick) override;
+
+private:
+    struct OpenBlock {
+        std::vector<uint8_t> data;
+        uint64_t firstTime = 0;
+        uint64_t lastTime = 0;
+        uint32_t changeCount = 0;
+        uint8_t startValue = 0;
+    };
+
+    void WriteBlock(uint32_t signal);
+
+    std::vector<std::string> signalNames;
+    std::vector<uint8_t> initialValues;
+    std::vector<uint8_t> values;
+    std::vector<OpenBlock> openBlocks;
+    std::vector<std::vector<TraceBlock>> blocks;
+    uint64_t startTime = 0;
+    uint64_t time = 0;
+    uint64_t fileOffset = 0;
+};
+
+#endif // TRACE_WRITER_H
@@ -0,0 +1,161 @@
+#include "TruthTable.h"
+#include "Aig.h"
+#include "StronglyConnected.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+// Words per task; each task reuses one buffer of node words
+constexpr size_t WORDS_PER_TASK = 64;
+
+// Lane patterns of the six inputs that vary within a word
+constexpr uint64_t LANE_PATTERNS[6] = {
+    0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull
+};
+
+} // namespace
+
+bool GenerateTruthTable(const Netlist& netlist, const std::vector<GateId>& selection,
+                        TruthTable& table, std::string& error) {
+    table = TruthTable();
+    std::vector<uint8_t> selected(netlist.GetGateCount(), 0);
+    if (selection.empty()) {
+        for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+            selected[gate] = netlist.IsValidGate(gate);
+        }
+    } else {
+        for (GateId gate : selection) {
+            if (netlist.IsValidGate(gate)) selected[gate] = 1;
+        }
+    }
+
+    // Inputs and outputs, both in slot order
+    std::vector<uint8_t> isInput(netlist.GetGateCount(), 0);
+    for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+        if (!selected[gate]) continue;
+        if (netlist.GetKind(gate) == GateKind::INPUT) {
+            isInput[gate] = 1;
+            continue;
+        }
+        for (NetId net : netlist.GetFanin(gate)) {
+            GateId driver = netlist.GetDriver(net);
+            if (driver != INVALID_GATE && !selected[driver]) isInput[driver] = 1;
+        }
+        bool read = false;
+        for (GateId reader : netlist.GetFanout(netlist.GetOutput(gate))) {
+            if (selected[reader]) {
+                read = true;
+                break;
+            }
+        }
+        if (!read) table.outputs.push_back(gate);
+    }
+    for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+        if (isInput[gate]) table.inputs.push_back(gate);
+    }
+    if (table.inputs.size() > MAX_TRUTH_TABLE_INPUTS) {
+        error = "too many inputs (" + std::to_string(table.inputs.size()) + ", at most " +
+                std::to_string(MAX_TRUTH_TABLE_INPUTS) + ")";
+        return false;
+    }
+
+    // Input i becomes AIG node i + 1; the rest follow in dependency order
+    Aig aig;
+    std::vector<AigLiteral> netLiterals(netlist.GetNetCount(), AIG_FALSE);
+    netLiterals[Netlist::CONST1] = AIG_TRUE;
+    for (GateId gate : table.inputs) {
+        netLiterals[netlist.GetOutput(gate)] = aig.AddInput();
+    }
+    SccDecomposition components = FindStronglyConnectedComponents(netlist);
+    for (size_t component = 0; component < components.GetComponentCount(); ++component) {
+        for (uint32_t i = components.componentOffsets[component]; i < components.componentOffsets[component + 1]; ++i) {
+            GateId gate = components.gates[i];
+            if (!selected[gate] || isInput[gate]) continue;
+            if (components.componentCyclic[component]) {
+                error = "the selection contains a combinational loop";
+                return false;
+            }
+            netLiterals[netlist.GetOutput(gate)] = LowerGateToAig(aig, netlist, gate, netLiterals);
+        }
+    }
+    std::vector<AigLiteral> outputLiterals;
+    for (GateId gate : table.outputs) {
+        outputLiterals.push_back(netLiterals[netlist.GetOutput(gate)]);
+    }
+
+    size_t inputCount = table.inputs.size();
+    table.wordCount = inputCount > 6 ? size_t(1) << (inputCount - 6) : 1;
+    table.outputWords.assign(table.outputs.size() * table.wordCount, 0);
+    uint64_t rowMask = inputCount >= 6 ? ~uint64_t(0) : (uint64_t(1) << (uint64_t(1) << inputCount)) - 1;
+
+    size_t taskCount = (table.wordCount + WORDS_PER_TASK - 1) / WORDS_PER_TASK;
+    ThreadPool::GetShared().ParallelFor(taskCount, [&](size_t task) {
+        std::vector<uint64_t> words(aig.GetNodeCount(), 0);
+        size_t end = std::min(table.wordCount, (task + 1) * WORDS_PER_TASK);
+        for (size_t word = task * WORDS_PER_TASK; word < end; ++word) {
+            for (size_t input = 0; input < inputCount; ++input) {
+                words[input + 1] = input < 6 ? LANE_PATTERNS[input]
+                                             : uint64_t(0) - ((word >> (input - 6)) & 1);
+            }
+            aig.Simulate(words.data());
+            for (size_t output = 0; output < outputLiterals.size(); ++output) {
+                table.outputWords[output * table.wordCount + word] =
+                    Aig::LiteralWord(words.data(), outputLiterals[output]) & rowMask;
+            }
+        }
+    });
+    return true;
+}
+
+void WriteTruthTableCsv(const TruthTable& table, std::ostream& out) {
+    std::string line;
+    for (GateId gate : table.inputs) line += "in" + std::to_string(gate) + ",";
+    for (GateId gate : table.outputs) line += "out" + std::to_string(gate) + ",";
+    if (!line.empty()) line.back() = '\n';
+    out << line;
+
+    // Rows are assembled in a reused buffer and written in large chunks
+    std::string buffer;
+    size_t width = 2 * (table.inputs.size() + table.outputs.size());
+    for (uint64_t row = 0; row < table.GetRowCount(); ++row) {
+        for (size_t input = 0; input < table.inputs.size(); ++input) {
+            buffer += static_cast<char>('0' + ((row >> input) & 1));
+            buffer += ',';
+        }
+        for (size_t output = 0; output < table.outputs.size(); ++output) {
+            buffer += table.GetOutput(row, output) ? '1' : '0';
+            buffer += ',';
+        }
+        if (width != 0) buffer.back() = '\n';
+        if (buffer.size() >= (1 << 20)) {
+            out << buffer;
+            buffer.clear();
+        }
+    }
+    out << buffer;
+}
+
+void WriteTruthTableWordsCsv(const TruthTable& table, std::ostream& out) {
+    std::string line = "first_row";
+    for (GateId gate : table.outputs) line += ",out" + std::to_string(gate);
+    out << line << '\n';
+
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    std::string buffer;
+    for (size_t word = 0; word < table.wordCount; ++word) {
+        buffer += std::to_string(uint64_t(word) * 64);
+        for (size_t output = 0; output < table.outputs.size(); ++output) {
+            uint64_t bits = table.outputWords[output * table.wordCount + word];
+            buffer += ',';
+            for (int shift = 60; shift >= 0; shift -= 4) buffer += HEX_DIGITS[(bits >> shift) & 0xF];
+        }
+        buffer += '\n';
+        if (buffer.size() >= (1 << 20)) {
+            out << buffer;
+            buffer.clear();
+        }
+    }
+    out << buffer;
+}
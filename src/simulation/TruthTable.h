@@ -0,0 +1,45 @@
+#ifndef TRUTH_TABLE_H
+#define TRUTH_TABLE_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Outputs of a combinational block for every combination of its inputs.
+// Row r sets input i to bit i of r.
+struct TruthTable {
+    std::vector<GateId> inputs;    // gates driving the inputs, in slot order
+    std::vector<GateId> outputs;   // in slot order
+    size_t wordCount = 0;          // 64 rows per word
+    std::vector<uint64_t> outputWords;  // output o is outputWords[o * wordCount, (o + 1) * wordCount)
+
+    uint64_t GetRowCount() const { return uint64_t(1) << inputs.size(); }
+    bool GetOutput(uint64_t row, size_t output) const {
+        return (outputWords[output * wordCount + row / 64] >> (row % 64)) & 1;
+    }
+};
+
+// Each extra input doubles the table; 2^28 rows take 32 MB per output
+constexpr size_t MAX_TRUTH_TABLE_INPUTS = 28;
+// Larger tables are written 64 rows per line; one character per cell would
+// take gigabytes
+constexpr uint64_t MAX_TRUTH_TABLE_CSV_ROWS = uint64_t(1) << 16;
+
+// Enumerates the selected gates (every gate when the selection is empty)
+// over all input combinations, 64 rows per AIG pass and blocks of rows
+// spread across the shared thread pool. INPUT gates and nets read from
+// outside the selection are the inputs; selected gates nothing in the
+// selection reads are the outputs. Fails on combinational loops and on
+// more than MAX_TRUTH_TABLE_INPUTS inputs.
+bool GenerateTruthTable(const Netlist& netlist, const std::vector<GateId>& selection,
+                        TruthTable& table, std::string& error);
+
+// One row per line, inputs then outputs, headed by the gate slots
+void WriteTruthTableCsv(const TruthTable& table, std::ostream& out);
+// One line per 64 rows: the first row, then each output as 16 hex digits
+// whose bit i is row first + i
+void WriteTruthTableWordsCsv(const TruthTable& table, std::ostream& out);
+
+#endif // TRUTH_TABLE_H
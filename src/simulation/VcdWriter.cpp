@@ -0,0 +1,73 @@
+#include "VcdWriter.h"
+
+VcdWriter::~VcdWriter() {
+    Close();
+}
+
+std::string VcdWriter::MakeIdentifier(size_t index) {
+    std::string identifier;
+    do {
+        identifier += static_cast<char>('!' + index % 94);
+        index /= 94;
+    } while (index != 0);
+    return identifier;
+}
+
+void AppendVcdHeader(std::string& out, const std::vector<std::string>& names, const std::vector<std::string>& identifiers,
+                     const std::vector<uint8_t>& initialValues, uint64_t tick) {
+    out += "$timescale 1ns $end\n$scope module circuit $end\n";
+    for (size_t i = 0; i < names.size(); ++i) {
+        out += "$var wire 1 " + identifiers[i] + " " + names[i] + " $end\n";
+    }
+    out += "$upscope $end\n$enddefinitions $end\n#" + std::to_string(tick) + "\n$dumpvars\n";
+    for (size_t i = 0; i < initialValues.size(); ++i) {
+        out += static_cast<char>('0' + initialValues[i]);
+        out += identifiers[i];
+        out += '\n';
+    }
+    out += "$end\n";
+}
+
+void VcdWriter::WriteHeader(const std::vector<std::string>& names, const std::vector<uint8_t>& initialValues,
+                            uint64_t tick) {
+    buffer.clear();
+    buffer.reserve(WRITE_BUFFER_SIZE * 2);
+    identifiers.resize(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        identifiers[i] = MakeIdentifier(i);
+    }
+    AppendVcdHeader(buffer, names, identifiers, initialValues, tick);
+    WriteIfFull();
+}
+
+void VcdWriter::WriteTick(uint64_t tick) {
+    buffer += '#';
+    buffer += std::to_string(tick);
+    buffer += '\n';
+    WriteIfFull();
+}
+
+void VcdWriter::WriteChange(uint32_t signal, uint8_t value) {
+    buffer += static_cast<char>('0' + value);
+    buffer += identifiers[signal];
+    buffer += '\n';
+    WriteIfFull();
+}
+
+void VcdWriter::Flush() {
+    std::fwrite(buffer.data(), 1, buffer.size(), file);
+    std::fflush(file);
+    buffer.clear();
+}
+
+void VcdWriter::WriteFooter(uint64_t) {
+    std::fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+}
+
+void VcdWriter::WriteIfFull() {
+    if (buffer.size() >= WRITE_BUFFER_SIZE) {
+        std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+}
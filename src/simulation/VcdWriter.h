@@ -0,0 +1,39 @@
+#ifndef VCD_WRITER_H
+#define VCD_WRITER_H
+
+#include "WaveformWriter.h"
+#include <string>
+
+// Streams waveforms as a Value Change Dump for external viewers, formatted
+// on the writer thread and written in large blocks
+class VcdWriter : public WaveformWriter {
+public:
+    using WaveformWriter::WaveformWriter;
+    ~VcdWriter() override;
+
+    // Short printable identifier code of a signal, base 94 from '!'
+    static std::string MakeIdentifier(size_t index);
+
+protected:
+    void WriteHeader(const std::vector<std::string>& names, const std::vector<uint8_t>& initialValues,
+                     uint64_t tick) override;
+    void WriteTick(uint64_t tick) override;
+    void WriteChange(uint32_t signal, uint8_t value) override;
+    void Flush() override;
+    void WriteFooter(uint64_t lastTick) override;
+
+private:
+    static constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+    void WriteIfFull();
+
+    std::string buffer;
+    std::vector<std::string> identifiers;
+};
+
+// Header shared with other VCD producers: timescale, one scope with a wire
+// per name and the initial values at `tick`
+void AppendVcdHeader(std::string& out, const std::vector<std::string>& names, const std::vector<std::string>& identifiers,
+                     const std::vector<uint8_t>& initialValues, uint64_t tick);
+
+#endif // VCD_WRITER_H
@@ -0,0 +1,111 @@
+#include "WaveformPyramid.h"
+#include <algorithm>
+
+WaveformPyramid::WaveformPyramid(size_t levelCapacity) : levelCapacity(std::max<size_t>(levelCapacity, FANOUT)) {}
+
+uint64_t WaveformPyramid::BucketWidth(uint32_t level) {
+    return uint64_t(1) << (2 * level);
+}
+
+void WaveformPyramid::Reset(const Netlist& netlist, const std::vector<NetId>& watchedNets, uint64_t tick) {
+    static_assert(FANOUT == 4, "BucketWidth assumes a fanout of four");
+    nets = watchedNets;
+    values.resize(nets.size());
+    for (size_t signal = 0; signal < nets.size(); ++signal) {
+        values[signal] = nets[signal] < netlist.GetNetCount() ? netlist.GetValueData()[nets[signal]] : 0;
+    }
+    entries.assign(LEVEL_COUNT * nets.size() * levelCapacity, PyramidSummary());
+    partials.assign(LEVEL_COUNT * nets.size(), PyramidSummary());
+    completed.assign(LEVEL_COUNT, 0);
+    origin = tick;
+    lastTick = tick;
+
+    // The starting tick is the first level 0 entry
+    for (uint32_t signal = 0; signal < nets.size(); ++signal) {
+        PyramidSummary& entry = Entry(0, signal, 0);
+        entry.low = entry.high = values[signal];
+        partials[nets.size() + signal].Merge(entry);
+    }
+    completed[0] = 1;
+}
+
+void WaveformPyramid::Capture(const Netlist& netlist, uint64_t tick) {
+    if (tick != lastTick + 1) {
+        Reset(netlist, nets, tick);
+        return;
+    }
+    lastTick = tick;
+
+    const uint8_t* current = netlist.GetValueData();
+    size_t netCount = netlist.GetNetCount();
+    size_t signalCount = nets.size();
+    uint64_t index = completed[0];
+    for (uint32_t signal = 0; signal < signalCount; ++signal) {
+        uint8_t value = nets[signal] < netCount ? current[nets[signal]] : 0;
+        PyramidSummary& entry = Entry(0, signal, index);
+        entry.transitions = value != values[signal];
+        entry.low = entry.high = value;
+        values[signal] = value;
+        partials[signalCount + signal].Merge(entry);
+    }
+    ++completed[0];
+
+    // Close every level whose bucket just filled
+    for (uint32_t level = 1; level < LEVEL_COUNT && completed[level - 1] % FANOUT == 0; ++level) {
+        PyramidSummary* partial = partials.data() + level * signalCount;
+        PyramidSummary* parent = level + 1 < LEVEL_COUNT ? partial + signalCount : nullptr;
+        for (uint32_t signal = 0; signal < signalCount; ++signal) {
+            Entry(level, signal, completed[level]) = partial[signal];
+            if (parent) parent[signal].Merge(partial[signal]);
+            partial[signal] = PyramidSummary();
+        }
+        ++completed[level];
+    }
+}
+
+PyramidSummary WaveformPyramid::Summarize(uint32_t signal, uint64_t begin, uint64_t end) const {
+    PyramidSummary summary;
+    begin = std::max(begin, origin);
+    end = std::min(end, lastTick + 1);
+
+    uint64_t tick = begin;
+    while (tick < end) {
+        uint64_t offset = tick - origin;
+        bool found = false;
+        // Coarsest held bucket that starts here and ends within the range
+        for (uint32_t level = LEVEL_COUNT; level-- > 0 && !found;) {
+            uint64_t width = BucketWidth(level);
+            uint64_t index = offset / width;
+            if (offset % width != 0 || index < FirstIndex(level) || index > completed[level]) continue;
+            uint64_t bucketEnd = index < completed[level] ? (index + 1) * width : PartialEnd(level);
+            if (bucketEnd <= offset || origin + bucketEnd > end) continue;
+            summary.Merge(index < completed[level] ? Entry(level, signal, index) : partials[level * nets.size() + signal]);
+            tick = origin + bucketEnd;
+            found = true;
+        }
+
+        // Fine levels overwritten: the enclosing bucket of the finest level
+        // still holding it stands in, spilling past the range
+        for (uint32_t level = 1; level < LEVEL_COUNT && !found; ++level) {
+            uint64_t index = offset / BucketWidth(level);
+            if (index < FirstIndex(level)) continue;
+            bool complete = index < completed[level];
+            summary.Merge(complete ? Entry(level, signal, index) : partials[level * nets.size() + signal]);
+            tick = origin + (complete ? (index + 1) * BucketWidth(level) : PartialEnd(level));
+            found = true;
+        }
+        if (!found) break;
+    }
+    return summary;
+}
+
+void WaveformPyramid::Sample(uint32_t signal, uint64_t begin, uint64_t end, size_t columns,
+                             std::vector<PyramidSummary>& out) const {
+    out.resize(columns);
+    uint64_t span = end > begin ? end - begin : 0;
+    for (size_t column = 0; column < columns; ++column) {
+        uint64_t columnBegin = begin + span * column / columns;
+        uint64_t columnEnd = std::max(begin + span * (column + 1) / columns, columnBegin + 1);
+        out[column] = Summarize(signal, columnBegin, columnEnd);
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef WAVEFORM_PYRAMID_H
+#define WAVEFORM_PYRAMID_H
+
+#include "Netlist.h"
+#include "WaveformSink.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Summary of a signal over a stretch of ticks. An empty summary has
+// low = 1 and high = 0.
+struct PyramidSummary {
+    uint32_t transitions = 0;
+    uint8_t low = 1;
+    uint8_t high = 0;
+
+    bool IsEmpty() const { return low > high; }
+    void Merge(const PyramidSummary& other) {
+        transitions += other.transitions;
+        low = low < other.low ? low : other.low;
+        high = high > other.high ? high : other.high;
+    }
+};
+
+// Multi-resolution summaries of the watched nets for zoomed-out timing
+// views, built incrementally as the simulation runs. Level 0 holds one
+// entry per tick and every level above merges FANOUT entries of the one
+// below, like mipmaps. Each level keeps its latest entries in a ring, so
+// fine detail covers the recent past and coarse levels reach much further
+// back, in bounded memory.
+//
+// A range query walks down from the coarsest aligned bucket that fits, so
+// drawing any window costs a few entries per column however many ticks it
+// spans. A rewind restarts the pyramid.
+class WaveformPyramid : public WaveformSink {
+public:
+    static constexpr uint32_t FANOUT = 4;
+    static constexpr uint32_t LEVEL_COUNT = 16;
+    static constexpr size_t DEFAULT_LEVEL_CAPACITY = 1024;
+
+    explicit WaveformPyramid(size_t levelCapacity = DEFAULT_LEVEL_CAPACITY);
+
+    // Starts over watching `nets` from their values at `tick`
+    void Reset(const Netlist& netlist, const std::vector<NetId>& nets, uint64_t tick);
+    void Capture(const Netlist& netlist, uint64_t tick) override;
+
+    const std::vector<NetId>& GetNets() const { return nets; }
+    uint64_t GetFirstTick() const { return origin; }
+    uint64_t GetLastTick() const { return lastTick; }
+
+    // Summary of a signal over ticks [begin, end). Where fine levels have
+    // been overwritten the enclosing coarse bucket stands in.
+    PyramidSummary Summarize(uint32_t signal, uint64_t begin, uint64_t end) const;
+    // One summary per column, the columns splitting [begin, end) evenly
+    void Sample(uint32_t signal, uint64_t begin, uint64_t end, size_t columns, std::vector<PyramidSummary>& out) const;
+
+private:
+    static uint64_t BucketWidth(uint32_t level);
+    PyramidSummary& Entry(uint32_t level, uint32_t signal, uint64_t index) {
+        return entries[(size_t(level) * nets.size() + signal) * levelCapacity + index % levelCapacity];
+    }
+    const PyramidSummary& Entry(uint32_t level, uint32_t signal, uint64_t index) const {
+        return entries[(size_t(level) * nets.size() + signal) * levelCapacity + index % levelCapacity];
+    }
+    // Oldest entry index still held on a level
+    uint64_t FirstIndex(uint32_t level) const {
+        return completed[level] > levelCapacity ? completed[level] - levelCapacity : 0;
+    }
+
+    // Ticks since the origin covered by a level's bucket being filled,
+    // which holds only whole buckets of the level below
+    uint64_t PartialEnd(uint32_t level) const {
+        return level == 0 ? completed[0] : completed[level - 1] * BucketWidth(level - 1);
+    }
+
+    size_t levelCapacity;
+    std::vector<NetId> nets;
+    std::vector<uint8_t> values;
+    std::vector<PyramidSummary> entries;
+    // Per level and signal: the bucket being filled
+    std::vector<PyramidSummary> partials;
+    // Per level: buckets completed since the origin
+    std::vector<uint64_t> completed;
+    uint64_t origin = 0;
+    uint64_t lastTick = 0;
+};
+
+#endif // WAVEFORM_PYRAMID_H
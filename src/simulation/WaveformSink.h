@@ -0,0 +1,17 @@
+#ifndef WAVEFORM_SINK_H
+#define WAVEFORM_SINK_H
+
+#include <cstdint>
+
+class Netlist;
+
+// Receives the netlist's values after every simulation step. Called on the
+// simulation thread, so implementations must return quickly.
+class WaveformSink {
+public:
+    virtual ~WaveformSink() = default;
+
+    virtual void Capture(const Netlist& netlist, uint64_t tick) = 0;
+};
+
+#endif // WAVEFORM_SINK_H
@@ -0,0 +1,142 @@
+#include "WaveformWriter.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+constexpr std::chrono::milliseconds IDLE_SLEEP{1};
+// Buffered output is flushed once the queue has been idle this long
+constexpr std::chrono::milliseconds IDLE_FLUSH{100};
+
+} // namespace
+
+WaveformWriter::WaveformWriter(size_t queueCapacity) : queueCapacity(queueCapacity) {}
+
+WaveformWriter::~WaveformWriter() {
+    Close();
+}
+
+bool WaveformWriter::Open(const std::string& path, const Netlist& netlist, const std::vector<NetId>& dumpedNets,
+                          uint64_t tick, std::string& error) {
+    Close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "cannot write " + path;
+        return false;
+    }
+
+    nets = dumpedNets;
+    if (nets.empty()) {
+        for (GateId gate = 0; gate < netlist.GetGateCount(); ++gate) {
+            if (netlist.IsValidGate(gate)) nets.push_back(netlist.GetOutput(gate));
+        }
+    }
+    std::vector<std::string> names;
+    shadow.resize(nets.size());
+    for (size_t i = 0; i < nets.size(); ++i) {
+        GateId driver = netlist.GetDriver(nets[i]);
+        names.push_back(driver == INVALID_GATE ? "const" + std::to_string(nets[i])
+                                               : std::string(GetGateKindName(netlist.GetKind(driver))) + "_" + std::to_string(driver));
+        shadow[i] = netlist.GetNetValue(nets[i]);
+    }
+    queue = std::make_unique<SpscQueue<uint64_t>>(std::max(queueCapacity, (nets.size() + 1) * MIN_RESYNCS_QUEUED));
+    lastTick = tick;
+    capturedTick = tick;
+    resyncPending = false;
+    droppedTicks = 0;
+    stopping = false;
+    writer = std::thread(&WaveformWriter::WriterLoop, this, std::move(names), shadow, tick);
+    return true;
+}
+
+void WaveformWriter::Close() {
+    if (writer.joinable()) {
+        stopping = true;
+        writer.join();
+    }
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+void WaveformWriter::Capture(const Netlist& netlist, uint64_t tick) {
+    if (!IsOpen()) return;
+    if (tick <= lastTick) {
+        // Rewound; pick up again past the last written tick
+        resyncPending = true;
+        return;
+    }
+    capturedTick.store(tick, std::memory_order_relaxed);
+
+    const uint8_t* values = netlist.GetValueData();
+    size_t netCount = netlist.GetNetCount();
+    changed.clear();
+    for (uint32_t i = 0; i < nets.size(); ++i) {
+        uint8_t value = nets[i] < netCount ? values[nets[i]] : 0;
+        if (value != shadow[i]) {
+            shadow[i] = value;
+            changed.push_back(i);
+        }
+    }
+
+    if (resyncPending) {
+        if (!queue->HasSpace(nets.size() + 1)) {
+            ++droppedTicks;
+            return;
+        }
+        queue->TryPush(TICK_MARKER | tick);
+        for (uint32_t i = 0; i < nets.size(); ++i) {
+            queue->TryPush(uint64_t(i) << 1 | shadow[i]);
+        }
+        resyncPending = false;
+    } else if (!changed.empty()) {
+        if (!queue->HasSpace(changed.size() + 1)) {
+            ++droppedTicks;
+            resyncPending = true;
+            return;
+        }
+        queue->TryPush(TICK_MARKER | tick);
+        for (uint32_t i : changed) {
+            queue->TryPush(uint64_t(i) << 1 | shadow[i]);
+        }
+    } else {
+        return;
+    }
+    queue->Publish();
+    lastTick = tick;
+}
+
+void WaveformWriter::WriterLoop(std::vector<std::string> names, std::vector<uint8_t> initialValues, uint64_t initialTick) {
+    WriteHeader(names, initialValues, initialTick);
+
+    std::vector<uint64_t> entries(POP_BATCH);
+    auto idleSince = std::chrono::steady_clock::now();
+    bool flushed = false;
+    while (true) {
+        // Read the flag first so nothing pushed before Close() is missed
+        bool finishing = stopping;
+        size_t count = queue->TryPopMany(entries.data(), entries.size());
+        if (count == 0) {
+            if (finishing) break;
+            if (!flushed && std::chrono::steady_clock::now() - idleSince >= IDLE_FLUSH) {
+                Flush();
+                flushed = true;
+            }
+            std::this_thread::sleep_for(IDLE_SLEEP);
+            continue;
+        }
+        idleSince = std::chrono::steady_clock::now();
+        flushed = false;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t entry = entries[i];
+            if (entry & TICK_MARKER) {
+                WriteTick(entry & ~TICK_MARKER);
+            } else {
+                WriteChange(static_cast<uint32_t>(entry >> 1), static_cast<uint8_t>(entry & 1));
+            }
+        }
+    }
+    WriteFooter(capturedTick.load(std::memory_order_relaxed));
+    std::fflush(file);
+}
@@ -0,0 +1,89 @@
+#ifndef WAVEFORM_WRITER_H
+#define WAVEFORM_WRITER_H
+
+#include "Netlist.h"
+#include "SpscQueue.h"
+#include "WaveformSink.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Streams net value changes to a file without holding up the simulation.
+// Capture runs on the simulation thread and only diffs the dumped nets
+// against a shadow copy and pushes the changes into a lock-free queue; a
+// background thread hands them to the format hooks below. When the queue
+// is full the tick is dropped and counted rather than waited on, and every
+// dumped value is sent again once there is room, so a file never shows a
+// stale value for long.
+//
+// Times are simulation ticks. After a rewind nothing is dumped until the
+// run passes the last tick already sent.
+//
+// Derived writers must call Close() in their destructors, while their
+// hooks still exist.
+class WaveformWriter : public WaveformSink {
+public:
+    // Queue entries, 8 bytes each. The queue always holds a few full
+    // rewrites of the dumped nets so it can recover from drops.
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1 << 20;
+    static constexpr size_t MIN_RESYNCS_QUEUED = 4;
+
+    explicit WaveformWriter(size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+    ~WaveformWriter() override;
+
+    WaveformWriter(const WaveformWriter&) = delete;
+    WaveformWriter& operator=(const WaveformWriter&) = delete;
+
+    // Dumps the given nets, or the output of every gate when empty, starting
+    // from their current values at `tick`
+    bool Open(const std::string& path, const Netlist& netlist, const std::vector<NetId>& dumpedNets,
+              uint64_t tick, std::string& error);
+    // Writes out everything queued and closes the file
+    void Close();
+    bool IsOpen() const { return writer.joinable(); }
+
+    void Capture(const Netlist& netlist, uint64_t tick) override;
+
+    uint64_t GetDroppedTickCount() const { return droppedTicks; }
+
+protected:
+    // Format hooks, all called on the writer thread. A tick is followed by
+    // the signals that hold a new value from it on; after a drop the
+    // values may repeat the current ones.
+    virtual void WriteHeader(const std::vector<std::string>& names, const std::vector<uint8_t>& initialValues,
+                             uint64_t tick) = 0;
+    virtual void WriteTick(uint64_t tick) = 0;
+    virtual void WriteChange(uint32_t signal, uint8_t value) = 0;
+    // The queue has gone idle; write out anything buffered
+    virtual void Flush() = 0;
+    // `lastTick` is the last tick captured, changed or not
+    virtual void WriteFooter(uint64_t lastTick) = 0;
+
+    std::FILE* file = nullptr;
+
+private:
+    static constexpr uint64_t TICK_MARKER = uint64_t(1) << 63;
+    static constexpr size_t POP_BATCH = 4096;
+
+    void WriterLoop(std::vector<std::string> names, std::vector<uint8_t> initialValues, uint64_t initialTick);
+
+    size_t queueCapacity;
+    std::unique_ptr<SpscQueue<uint64_t>> queue;
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> droppedTicks{0};
+    std::atomic<uint64_t> capturedTick{0};
+
+    // Simulation thread only
+    std::vector<NetId> nets;
+    std::vector<uint8_t> shadow;
+    std::vector<uint32_t> changed;
+    uint64_t lastTick = 0;
+    bool resyncPending = false;
+};
+
+#endif // WAVEFORM_WRITER_H